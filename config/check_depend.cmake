@@ -209,6 +209,8 @@ if(OROCOS_TARGET STREQUAL "macosx")
   # Force OFF on mqueue transport on macosx
   message("Forcing ENABLE_MQ to OFF for macsox")
   set(ENABLE_MQ OFF CACHE BOOL "This option is forced to OFF by the build system on macosx platform." FORCE)
+  message("Forcing ENABLE_SHM to OFF for macosx")
+  set(ENABLE_SHM OFF CACHE BOOL "This option is forced to OFF by the build system on macosx platform." FORCE)
 
   # see also src/CMakeLists.txt as it adds the boost_thread library to OROCOS_RTT_LIBRARIES
   list(APPEND OROCOS-RTT_LIBRARIES ${PTHREAD_LIBRARIES} dl) 
@@ -251,6 +253,8 @@ if(OROCOS_TARGET STREQUAL "win32")
   # Force OFF on mqueue transport on WIN32 platform
   message("Forcing ENABLE_MQ to OFF for WIN32")
   set(ENABLE_MQ OFF CACHE BOOL "This option is forced to OFF by the build system on WIN32 platform." FORCE)
+  message("Forcing ENABLE_SHM to OFF for WIN32")
+  set(ENABLE_SHM OFF CACHE BOOL "This option is forced to OFF by the build system on WIN32 platform." FORCE)
   if (MINGW)
     #--enable-all-export and --enable-auto-import are already set by cmake.
     #but we need it here for the unit tests as well.
@@ -77,8 +77,16 @@ namespace RTT
         return result;
     }
 
+    ConnPolicy ConnPolicy::sharedData(int readers, int lock_policy /*= LOCK_FREE*/, bool init_connection /*= true*/)
+    {
+        ConnPolicy result(SHARED_DATA, lock_policy);
+        result.init = init_connection;
+        result.size = readers;
+        return result;
+    }
+
     ConnPolicy::ConnPolicy(int type /* = DATA*/, int lock_policy /*= LOCK_FREE*/)
-        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0) {}
+        : type(type), init(false), lock_policy(lock_policy), pull(false), size(0), transport(0), data_size(0), oneway(false) {}
 
     /** @cond */
     /** This is dead code. We use the boost::serialization now.
@@ -141,6 +149,13 @@ namespace RTT
             log(Error) <<"ConnPolicy: wrong property type of 'pull'."<<endlog();
             return false;
         }
+        b = bag.getProperty("oneway");
+        if ( b.ready() )
+            result.oneway = b.get();
+        else if ( bag.find("oneway") ){
+            log(Error) <<"ConnPolicy: wrong property type of 'oneway'."<<endlog();
+            return false;
+        }
 
         s = bag.getProperty("name_id");
         if ( s.ready() )
@@ -168,6 +183,7 @@ namespace RTT
         targetbag.ownProperty( new Property<int>("transport","The prefered transport. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<int>("data_size","A hint about the data size of a single data sample. Set to zero if unsure.", cp.transport));
         targetbag.ownProperty( new Property<string>("name_id","The name of the connection to be formed.",cp.name_id));
+        targetbag.ownProperty( new Property<bool>("oneway","Do not wait for the reader's process to receive pushed data", cp.oneway));
     }
     /** @endcond */
 
@@ -49,15 +49,29 @@ namespace RTT {
      * behave. Various parameters are available:
      *
      * <ul>
-     *  <li> the connection type: DATA, BUFFER or CIRCULAR_BUFFER. On a data connection, the reader will have
+     *  <li> the connection type: DATA, BUFFER, CIRCULAR_BUFFER or SHARED_DATA. On a data connection, the reader will have
      *       only access to the last written value. On a buffered connection, a
      *       \a size number of elements can be stored until the reader reads
      *       them. BUFFER drops newer samples on full, CIRCULAR_BUFFER drops older samples on full.
-     *  <li> the locking policy: LOCKED, LOCK_FREE or UNSYNC. This defines how locking is done in the
-     *       connection. For now, only three policies are available. LOCKED uses
+     *       SHARED_DATA behaves like DATA, but all local SHARED_DATA connections of one
+     *       output port share a single data sample, such that a write() costs one copy
+     *       whatever the number of readers. Each reader still gets its own NewData/OldData status.
+     *       The \a size is then the number of readers that may read concurrently, which
+     *       sizes the lock-free storage when the first shared connection is created, with
+     *       a minimum of 8. Further shared connections must use the same locking policy
+     *       and are refused when all readers are taken.
+     *       Remote connections fall back to DATA.
+     *  <li> the locking policy: LOCKED, LOCK_FREE, SPSC or UNSYNC. This defines how locking is done in the
+     *       connection. LOCKED uses
      *       mutexes, LOCK_FREE uses a lock free method and UNSYNC means there's no
      *       synchronisation at all (not thread safe). The latter should
      *       be used only when there is no contention (simultaneous write-read).
+     *       SPSC (single producer, single consumer) uses a wait-free BUFFER which
+     *       stores the samples in place. It may only be used if the output port is
+     *       written by a single thread. Other connection types use LOCK_FREE instead.
+     *       SEQLOCK uses a DATA storage based on a sequence counter, of which
+     *       the reads scale with the number of readers. It is meant for (SHARED_)DATA
+     *       connections of plain old data types. Other connections use LOCK_FREE instead.
      *
      *  <li> if, upon connection, the last value that has been written on the
      *       writer end should be written on the connection as well to
@@ -70,6 +84,12 @@ namespace RTT {
      *       default), new data is actively pushed to the reader's process. In
      *       the pulled case, data must be requested by the reader.
      *
+     *  <li> if pushed data is sent one way. This has an effect only on
+     *       multi-process communication. The writer's process then does not
+     *       wait until the reader's process received the data, which suits
+     *       fire-and-forget DATA connections. The writer is not informed when
+     *       a sample could not be delivered.
+     *
      *  <li> the transport type. Can be used to force a certain kind of transports.
      *       The number is a RTT transport id. When the transport type is zero,
      *       local in-process communication is used, unless one of the ports is
@@ -93,10 +113,13 @@ namespace RTT {
         static const int DATA   = 0;
         static const int BUFFER = 1;
         static const int CIRCULAR_BUFFER = 2;
+        static const int SHARED_DATA = 3;
 
         static const int UNSYNC    = 0;
         static const int LOCKED    = 1;
         static const int LOCK_FREE = 2;
+        static const int SPSC      = 3;
+        static const int SEQLOCK   = 4;
 
         /**
          * Create a policy for a (lock-free) fifo buffer connection of a given size.
@@ -127,6 +150,17 @@ namespace RTT {
          */
         static ConnPolicy data(int lock_policy = LOCK_FREE, bool init_connection = true, bool pull = false);
 
+        /**
+         * Create a policy for a data connection which shares its data sample with
+         * all other shared connections of the same output port.
+         * @param readers The number of readers that may read the sample concurrently.
+         * Only used by the first shared connection of an output port, which creates the storage.
+         * @param lock_policy The locking policy
+         * @param init_connection If the reader should be initialised with the last value of the OutputPort upon creation.
+         * @return the specified policy.
+         */
+        static ConnPolicy sharedData(int readers, int lock_policy = LOCK_FREE, bool init_connection = true);
+
         /**
          * The default policy is data driven, lock-free and local.
          * It is unsafe to rely on these defaults. It is prefered
@@ -137,7 +171,7 @@ namespace RTT {
          */
         explicit ConnPolicy(int type = DATA, int lock_policy = LOCK_FREE);
 
-        /** DATA, BUFFER or CIRCULAR_BUFFER */
+        /** DATA, BUFFER, CIRCULAR_BUFFER or SHARED_DATA */
         int    type;
         /** If true, one should initialize the connection's value with the last
          * value written on the writer port. This is only possible if the writer
@@ -152,7 +186,8 @@ namespace RTT {
          * data is available by base::ChannelElementBase::signal()
          */
         bool   pull;
-        /** If the connection is a buffered connection, the size of the buffer */
+        /** If the connection is a buffered connection, the size of the buffer.
+         * For SHARED_DATA, the number of concurrent readers. */
         int    size;
         /**
          * The prefered transport used. 0 is local (in process), a higher number
@@ -177,6 +212,13 @@ namespace RTT {
          * work around name clashes or if the transport protocol documents to do so.
          */
         mutable std::string name_id;
+
+        /**
+         * If true, pushed data is sent without waiting for the reader's
+         * process to acknowledge it. Only used by transports which support
+         * this, like CORBA, and only when \a pull is false.
+         */
+        bool   oneway;
     };
 }
 
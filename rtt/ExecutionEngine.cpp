@@ -42,7 +42,8 @@
 #include "base/TaskCore.hpp"
 #include "rtt-fwd.hpp"
 #include "os/MutexLock.hpp"
-#include "internal/MWSRQueue.hpp"
+#include "os/TimeService.hpp"
+#include "internal/ResizableMWSRQueue.hpp"
 #include "TaskContext.hpp"
 
 #include <boost/bind.hpp>
@@ -53,6 +54,7 @@
 #include <algorithm>
 
 #define ORONUM_EE_MQUEUE_SIZE 100
+#define ORONUM_EE_BLOCK_PERIOD_NS 10000000
 
 namespace RTT
 {
@@ -69,9 +71,21 @@ namespace RTT
 
     ExecutionEngine::ExecutionEngine( TaskCore* owner )
         : taskc(owner),
-          mqueue(new MWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) )
+          f_running(0),
+          send_lane(NormalLane),
+          msg_waiters(0),
+          mbatch_next(0), mbatch_count(0), mbatch_size(MAX_MESSAGE_BATCH),
+          profiling(false), profile_reset(false), profile_restart(false), profile_last_start(0)
     {
+        for (int lane = 0; lane != LaneCount; ++lane) {
+            mqueue[lane] = new ResizableMWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE);
+            f_queue[lane] = new ResizableMWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE);
+            f_head[lane] = f_tail[lane] = 0;
+            f_count[lane] = 0;
+            lane_budget[lane] = 0;
+            lane_policy[lane] = DropOnOverflow;
+            lane_high_water[lane] = 0;
+        }
     }
 
     ExecutionEngine::~ExecutionEngine()
@@ -85,16 +99,28 @@ namespace RTT
         }
         assert( children.empty() );
 
-        ExecutableInterface* foo;
-        while ( f_queue->dequeue( foo ) )
-            foo->unloaded();
+        for (int lane = 0; lane != LaneCount; ++lane) {
+            adoptFunctions( lane );
+            while ( f_head[lane] ) {
+                ExecutableInterface* foo = f_head[lane];
+                unlinkFunction( foo );
+                foo->unloaded();
+            }
+        }
+
+        while ( mbatch_next != mbatch_count )
+            mbatch[mbatch_next++]->dispose();
 
-        DisposableInterface* dis;
-        while ( mqueue->dequeue( dis ) )
-            dis->dispose();
+        for (int lane = 0; lane != LaneCount; ++lane) {
+            DisposableInterface* dis;
+            while ( mqueue[lane]->dequeue( dis ) )
+                dis->dispose();
+            for (deque<DisposableInterface*>::iterator it = spill[lane].begin(); it != spill[lane].end(); ++it)
+                (*it)->dispose();
 
-        delete f_queue;
-        delete mqueue;
+            delete f_queue[lane];
+            delete mqueue[lane];
+        }
     }
 
     TaskCore* ExecutionEngine::getParent() {
@@ -111,33 +137,90 @@ namespace RTT
             children.erase(it);
     }
 
-    void ExecutionEngine::processFunctions()
+    void ExecutionEngine::adoptFunctions(int lane)
     {
-        // Execute all loaded Functions :
         ExecutableInterface* foo = 0;
-        int nbr = f_queue->size(); // nbr to process.
-        // 1. Fetch new ones from queue.
-        while ( f_queue->dequeue(foo) ) {
-            assert(foo);
-            if ( foo->execute() == false ){
-                foo->unloaded();
-                msg_cond.broadcast(); // required for waitForFunctions() (3rd party thread)
-            } else {
-                f_queue->enqueue( foo );
+        while ( f_queue[lane]->dequeue( foo ) )
+            if ( foo->run_lane == -1 ) // ignore a second runFunction().
+                linkFunction( foo, lane );
+    }
+
+    void ExecutionEngine::linkFunction(ExecutableInterface* f, int lane)
+    {
+        assert( f->run_lane == -1 );
+        f->run_lane = lane;
+        f->run_next = 0;
+        f->run_prev = f_tail[lane];
+        if ( f_tail[lane] )
+            f_tail[lane]->run_next = f;
+        else
+            f_head[lane] = f;
+        f_tail[lane] = f;
+        ++f_count[lane];
+    }
+
+    void ExecutionEngine::unlinkFunction(ExecutableInterface* f)
+    {
+        int lane = f->run_lane;
+        assert( lane >= 0 && lane < LaneCount );
+        if ( f->run_prev )
+            f->run_prev->run_next = f->run_next;
+        else
+            f_head[lane] = f->run_next;
+        if ( f->run_next )
+            f->run_next->run_prev = f->run_prev;
+        else
+            f_tail[lane] = f->run_prev;
+        f->run_prev = f->run_next = 0;
+        f->run_lane = -1;
+        --f_count[lane];
+    }
+
+    void ExecutionEngine::processFunctions()
+    {
+        // Execute all loaded Functions, highest lane first :
+        for (int lane = 0; lane != LaneCount; ++lane) {
+            // 1. Fetch new ones from queue.
+            f_queue[lane]->refresh(); // finish a resize of an idle lane.
+            adoptFunctions( lane );
+            unsigned int nbr = f_count[lane]; // nbr to process.
+            // a budget rotates through the functions over several steps.
+            if ( lane_budget[lane] != 0 && nbr > lane_budget[lane] )
+                nbr = lane_budget[lane];
+            // 2. Execute from the head, re-append to the tail.
+            while ( nbr != 0 && f_head[lane] ) {
+                ExecutableInterface* foo = f_head[lane];
+                unlinkFunction( foo );
+                RunningFunction running = { foo, false, f_running };
+                f_running = &running;
+                bool keep = foo->execute();
+                f_running = running.up;
+                if ( keep == false ){
+                    foo->unloaded();
+                    signalWaiters(); // required for waitForFunctions() (3rd party thread)
+                } else if ( !running.removed ) {
+                    linkFunction( foo, lane );
+                }
+                --nbr;
             }
-            if ( --nbr == 0) // we did a round-trip
-                break;
         }
     }
 
     bool ExecutionEngine::runFunction( ExecutableInterface* f )
     {
-        if (this->getActivity() && f) {
+        return runFunction( f, NormalLane );
+    }
+
+    bool ExecutionEngine::runFunction( ExecutableInterface* f, Lane lane )
+    {
+        if (this->getActivity() && f && lane >= 0 && lane < LaneCount) {
             // We only reject running functions when we're in the FatalError state.
             if (taskc && taskc->mTaskState == TaskCore::FatalError )
                 return false;
             f->loaded(this);
-            bool result = f_queue->enqueue( f );
+            bool result = f_queue[lane]->enqueue( f );
+            if ( !result )
+                lane_drops[lane].inc();
             // signal work is to be done:
             this->getActivity()->trigger();
             return result;
@@ -191,17 +274,17 @@ namespace RTT
         // since this function is executed in process messages, it is always safe to execute.
         if ( !f )
             return false;
-        int nbr = f_queue->size();
-        while (nbr != 0) {
-            ExecutableInterface* foo = 0;
-            if ( !f_queue->dequeue(foo) )
-                return false;
-            if ( f  == foo) {
-                return true;
-            }
-            f_queue->enqueue(foo);
-            --nbr;
+        // f may not have been adopted yet.
+        for (int lane = 0; lane != LaneCount; ++lane)
+            adoptFunctions( lane );
+        if ( f->run_lane != -1 && f->engine == this ) {
+            unlinkFunction( f );
+            return true;
         }
+        // f may be removing itself from within its execute().
+        for (RunningFunction* r = f_running; r; r = r->up)
+            if ( r->f == f )
+                r->removed = true;
         return true;
     }
 
@@ -212,45 +295,286 @@ namespace RTT
 
     bool ExecutionEngine::hasWork()
     {
-        return !mqueue->isEmpty();
+        if ( mbatch_next != mbatch_count )
+            return true;
+        for (int lane = 0; lane != LaneCount; ++lane)
+            if ( !mqueue[lane]->isEmpty() || spill_count[lane].read() != 0 )
+                return true;
+        return false;
+    }
+
+    void ExecutionEngine::setLaneBudget(Lane lane, unsigned int budget)
+    {
+        if ( lane >= 0 && lane < LaneCount )
+            lane_budget[lane] = budget;
+    }
+
+    unsigned int ExecutionEngine::getLaneBudget(Lane lane) const
+    {
+        if ( lane >= 0 && lane < LaneCount )
+            return lane_budget[lane];
+        return 0;
+    }
+
+    bool ExecutionEngine::setLaneCapacity(Lane lane, unsigned int capacity)
+    {
+        if ( lane < 0 || lane >= LaneCount || capacity == 0 )
+            return false;
+        // check both queues first, such that we never resize only one.
+        // Only the engine can make a busy queue resizable again, so
+        // the checks hold while we keep other resizes out.
+        os::MutexLock lock( capacity_lock );
+        if ( !mqueue[lane]->isResizable() || !f_queue[lane]->isResizable() ) {
+            log(Warning) << "ExecutionEngine: could not resize lane "<< lane
+                         <<" to "<< capacity << ", it is still draining a previous resize." << endlog();
+            return false;
+        }
+        // the current contents remain in the old queues until
+        // the engine has processed them.
+        mqueue[lane]->resize( capacity );
+        f_queue[lane]->resize( capacity );
+        // nobody else is reading the queues when we're not active.
+        if ( getActivity() == 0 || !getActivity()->isActive() ) {
+            mqueue[lane]->refresh();
+            f_queue[lane]->refresh();
+        }
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getLaneCapacity(Lane lane) const
+    {
+        if ( lane >= 0 && lane < LaneCount )
+            return mqueue[lane]->capacity();
+        return 0;
+    }
+
+    void ExecutionEngine::setLaneOverflowPolicy(Lane lane, OverflowPolicy policy)
+    {
+        if ( lane >= 0 && lane < LaneCount )
+            lane_policy[lane] = policy;
+    }
+
+    ExecutionEngine::OverflowPolicy ExecutionEngine::getLaneOverflowPolicy(Lane lane) const
+    {
+        if ( lane >= 0 && lane < LaneCount )
+            return lane_policy[lane];
+        return DropOnOverflow;
+    }
+
+    ExecutionEngine::LaneStatistics ExecutionEngine::getLaneStatistics(Lane lane) const
+    {
+        LaneStatistics ls;
+        if ( lane >= 0 && lane < LaneCount ) {
+            ls.high_water = lane_high_water[lane];
+            ls.drops = lane_drops[lane].read();
+            ls.spills = lane_spills[lane].read();
+            ls.blocks = lane_blocks[lane].read();
+        }
+        return ls;
+    }
+
+    void ExecutionEngine::resetLaneStatistics(Lane lane)
+    {
+        if ( lane >= 0 && lane < LaneCount ) {
+            lane_high_water[lane] = 0;
+            lane_drops[lane].set(0);
+            lane_spills[lane].set(0);
+            lane_blocks[lane].set(0);
+        }
+    }
+
+    void ExecutionEngine::setSendLane(Lane lane)
+    {
+        if ( lane >= 0 && lane < LaneCount )
+            send_lane = lane;
+    }
+
+    bool ExecutionEngine::setMessageBatchSize(unsigned int n)
+    {
+        if ( n == 0 || n > MAX_MESSAGE_BATCH )
+            return false;
+        mbatch_size = n;
+        return true;
+    }
+
+    unsigned int ExecutionEngine::getMessageBatchSize() const
+    {
+        return mbatch_size;
+    }
+
+    ExecutionEngine::MessageStatistics ExecutionEngine::getMessageStatistics() const
+    {
+        return mstats;
+    }
+
+    void ExecutionEngine::resetMessageStatistics()
+    {
+        mstats = MessageStatistics();
+    }
+
+    void ExecutionEngine::signalWaiters()
+    {
+        // The atomic test is a full memory barrier, such that a waiter
+        // which registered itself after this test is guaranteed
+        // to see the effects of the executed messages in its pred().
+        if ( msg_waiters.sub_and_test(0) )
+            return;
+        // We must hold the lock once between executeAndDispose
+        // and the broadcast to avoid the race condition in
+        // waitForMessages().
+        {
+            MutexLock locker( msg_lock );
+        }
+        msg_cond.broadcast();
     }
 
     void ExecutionEngine::processMessages()
     {
         // execute all commands from the AtomicQueue.
         // msg_lock may not be held when entering this function !
-        DisposableInterface* com(0);
-        {
-            while ( mqueue->dequeue(com) ) {
-                assert( com );
-                com->executeAndDispose();
+        // The batch is kept in members, such that a recursive call
+        // first executes the messages we already dequeued.
+        bool work = false;
+        bool pending = false;
+        while ( mbatch_next != mbatch_count ) {
+            DisposableInterface* com = mbatch[mbatch_next++];
+            assert( com );
+            com->executeAndDispose();
+            work = true;
+        }
+        for (int lane = 0; lane != LaneCount; ++lane) {
+            unsigned int budget = lane_budget[lane];
+            unsigned int done = 0;
+            unsigned int depth = mqueue[lane]->size();
+            if ( depth > lane_high_water[lane] )
+                lane_high_water[lane] = depth;
+            while ( budget == 0 || done != budget ) {
+                unsigned int max = mbatch_size;
+                if ( budget != 0 && budget - done < max )
+                    max = budget - done;
+                mbatch_next = 0;
+                mbatch_count = mqueue[lane]->dequeue( mbatch, max );
+                if ( mbatch_count == 0 ) {
+                    // the spilled messages follow the queued ones.
+                    if ( spill_count[lane].read() != 0 && unspill( Lane(lane) ) )
+                        continue;
+                    break;
+                }
+                done += mbatch_count;
+                ++mstats.batches;
+                mstats.messages += mbatch_count;
+                mstats.last_batch = mbatch_count;
+                if ( mbatch_count > mstats.max_batch )
+                    mstats.max_batch = mbatch_count;
+                while ( mbatch_next != mbatch_count ) {
+                    DisposableInterface* com = mbatch[mbatch_next++];
+                    assert( com );
+                    com->executeAndDispose();
+                }
+                work = true;
             }
-            // there's no need to hold the lock during
-            // emptying the queue. But we must hold the
-            // lock once between excuteAndDispose and the
-            // broadcast to avoid the race condition in
-            // waitForMessages().
-            // This allows us to recurse into processMessages.
-            MutexLock locker( msg_lock );
+            if ( budget != 0 && done == budget
+                 && ( !mqueue[lane]->isEmpty() || spill_count[lane].read() != 0 ) )
+                pending = true;
         }
-        if ( com )
-            msg_cond.broadcast(); // required for waitForMessages() (3rd party thread)
+        if ( work )
+            signalWaiters(); // required for waitForMessages() (3rd party thread)
+        // the budget left messages for the next step:
+        if ( pending && this->getActivity() )
+            this->getActivity()->trigger();
     }
 
     bool ExecutionEngine::process( DisposableInterface* c )
     {
-        if ( c && this->getActivity() ) {
+        return process( c, NormalLane );
+    }
+
+    bool ExecutionEngine::process( DisposableInterface* c, Lane lane )
+    {
+        if ( c && this->getActivity() && lane >= 0 && lane < LaneCount ) {
             // We only reject running functions when we're in the FatalError state.
             if (taskc && taskc->mTaskState == TaskCore::FatalError )
                 return false;
-            bool result = mqueue->enqueue( c );
+            bool result;
+            // keep the order of a producer once it started spilling:
+            if ( lane_policy[lane] == SpillOnOverflow && spill_count[lane].read() != 0 )
+                result = overflow( c, lane );
+            else
+                result = mqueue[lane]->enqueue( c ) || overflow( c, lane );
             this->getActivity()->trigger();
-            msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
+            signalWaiters(); // required for waitAndProcessMessages() (EE thread)
             return result;
         }
         return false;
     }
 
+    bool ExecutionEngine::overflow( DisposableInterface* c, Lane lane )
+    {
+        switch ( lane_policy[lane] ) {
+        case SpillOnOverflow:
+            {
+                os::MutexLock lock( spill_lock[lane] );
+                spill[lane].push_back( c );
+                spill_count[lane].inc();
+            }
+            lane_spills[lane].inc();
+            return true;
+        case BlockOnOverflow:
+            // we can not wait for ourselves.
+            if ( this->getActivity()->thread()->isSelf() || !this->getActivity()->isActive() )
+                break;
+            lane_blocks[lane].inc();
+            this->getActivity()->trigger();
+            {
+                {
+                    os::MutexLock lock( msg_lock );
+                    msg_waiters.inc();
+                }
+                // we only take msg_lock to wait, never while enqueueing, so
+                // the engine is not held up. Since we are counted in
+                // msg_waiters, processMessages() takes the lock after freeing
+                // slots, which can not happen between our isFull() and wait.
+                bool result = false;
+                while ( this->getActivity()->isActive() ) {
+                    if ( mqueue[lane]->enqueue( c ) ) {
+                        result = true;
+                        break;
+                    }
+                    os::MutexLock lock( msg_lock );
+                    // processMessages() signals us, the timeout only checks isActive().
+                    if ( mqueue[lane]->isFull() )
+                        msg_cond.wait_until( msg_lock, rtos_get_time_ns() + ORONUM_EE_BLOCK_PERIOD_NS );
+                }
+                {
+                    os::MutexLock lock( msg_lock );
+                    msg_waiters.dec();
+                }
+                if ( result )
+                    return true;
+            }
+            break;
+        case DropOnOverflow:
+            break;
+        }
+        lane_drops[lane].inc();
+        return false;
+    }
+
+    bool ExecutionEngine::unspill( Lane lane )
+    {
+        // never block the engine on a producer which is spilling.
+        if ( !spill_lock[lane].trylock() )
+            return false;
+        bool moved = false;
+        while ( !spill[lane].empty() && mqueue[lane]->enqueue( spill[lane].front() ) ) {
+            spill[lane].pop_front();
+            spill_count[lane].dec();
+            moved = true;
+        }
+        spill_lock[lane].unlock();
+        return moved;
+    }
+
     void ExecutionEngine::waitForMessages(const boost::function<bool(void)>& pred)
     {
         if (this->getActivity()->thread()->isSelf())
@@ -275,9 +599,11 @@ namespace RTT
             return;
         // only to be called from the thread not executing step().
         os::MutexLock lock(msg_lock);
+        msg_waiters.inc();
         while (!pred()) { // the mutex guards that processMessages can not run between !pred and the wait().
             msg_cond.wait(msg_lock); // now processMessages may run.
         }
+        msg_waiters.dec();
     }
 
 
@@ -290,9 +616,12 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
+                msg_waiters.inc();
                 if (!pred()) {
                     msg_cond.wait(msg_lock); // now processMessages may run.
+                    msg_waiters.dec();
                 } else {
+                    msg_waiters.dec();
                     return; // do not process messages when pred() == true;
                 }
             }
@@ -308,9 +637,12 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
+                msg_waiters.inc();
                 if (!pred()) {
                     msg_cond.wait(msg_lock); // now processMessages may run.
+                    msg_waiters.dec();
                 } else {
+                    msg_waiters.dec();
                     return; // do not process messages when pred() == true;
                 }
             }
@@ -318,9 +650,86 @@ namespace RTT
     }
 
     void ExecutionEngine::step() {
+        if ( !profiling ) {
+            processMessages();
+            processFunctions();
+            processChildren(); // aren't these ExecutableInterfaces ie functions ?
+            return;
+        }
+        os::TimeService* ts = os::TimeService::Instance();
+        nsecs start = ts->getNSecs();
         processMessages();
+        nsecs t1 = ts->getNSecs();
         processFunctions();
-        processChildren(); // aren't these ExecutableInterfaces ie functions ?
+        nsecs t2 = ts->getNSecs();
+        processChildren();
+        nsecs t3 = ts->getNSecs();
+
+        // the previous start is unknown after enabling.
+        if ( profile_restart ) {
+            profile_restart = false;
+            profile_last_start = 0;
+        }
+        if ( profile_reset ) {
+            profile_reset = false;
+            profile_last_start = 0;
+            for (int p = 0; p != ProfilePhaseCount; ++p)
+                profile[p] = PhaseStatistics();
+        }
+        addProfileSample( MessagesPhase, t1 - start );
+        addProfileSample( FunctionsPhase, t2 - t1 );
+        addProfileSample( UpdatePhase, t3 - t2 );
+        Seconds period = this->getActivity() ? this->getActivity()->getPeriod() : 0.0;
+        if ( period > 0.0 && profile_last_start != 0 ) {
+            nsecs jitter = (start - profile_last_start) - Seconds_to_nsecs( period );
+            addProfileSample( CycleJitter, jitter < 0 ? -jitter : jitter );
+        }
+        profile_last_start = start;
+
+        // publish, but never wait for a reader.
+        if ( profile_lock.trylock() ) {
+            for (int p = 0; p != ProfilePhaseCount; ++p)
+                profile_pub[p] = profile[p];
+            profile_lock.unlock();
+        }
+    }
+
+    void ExecutionEngine::addProfileSample(ProfilePhase phase, nsecs sample)
+    {
+        PhaseStatistics& ps = profile[phase];
+        if ( ps.count == 0 || sample < ps.min )
+            ps.min = sample;
+        if ( sample > ps.max )
+            ps.max = sample;
+        ++ps.count;
+        ps.total += sample;
+        unsigned int b = 0;
+        for (nsecs us = sample / 1000; us != 0 && b != PROFILE_BUCKETS - 1; us >>= 1)
+            ++b;
+        ++ps.histogram[b];
+    }
+
+    void ExecutionEngine::setProfiling(bool on)
+    {
+        if ( on && !profiling )
+            profile_restart = true;
+        profiling = on;
+    }
+
+    ExecutionEngine::PhaseStatistics ExecutionEngine::getPhaseStatistics(ProfilePhase phase) const
+    {
+        if ( phase < 0 || phase >= ProfilePhaseCount )
+            return PhaseStatistics();
+        os::MutexLock lock( profile_lock );
+        return profile_pub[phase];
+    }
+
+    void ExecutionEngine::resetProfile()
+    {
+        profile_reset = true;
+        os::MutexLock lock( profile_lock );
+        for (int p = 0; p != ProfilePhaseCount; ++p)
+            profile_pub[p] = PhaseStatistics();
     }
 
     void ExecutionEngine::processChildren() {
@@ -42,12 +42,15 @@
 #include "os/Mutex.hpp"
 #include "os/MutexLock.hpp"
 #include "os/Condition.hpp"
+#include "os/Atomic.hpp"
+#include "Time.hpp"
 #include "base/RunnableInterface.hpp"
 #include "base/ActivityInterface.hpp"
 #include "base/DisposableInterface.hpp"
 #include "base/ExecutableInterface.hpp"
 #include "internal/List.hpp"
 #include <vector>
+#include <deque>
 #include <boost/function.hpp>
 
 #include "rtt-config.h"
@@ -78,6 +81,32 @@ namespace RTT
         : public base::RunnableInterface
     {
     public:
+        /**
+         * The priority lanes in which messages and functions are queued.
+         * In each step(), the lanes are processed in this order, such that
+         * a flood of messages in a lower lane can not delay the
+         * messages in a higher lane by more than that lane's budget.
+         * @see setLaneBudget, setLaneCapacity
+         */
+        enum Lane { CriticalLane = 0, NormalLane, BackgroundLane, LaneCount };
+
+        /**
+         * What process() does with a message when its lane is full.
+         * @see setLaneOverflowPolicy
+         */
+        enum OverflowPolicy {
+            /** Reject the message, process() returns false (the default). */
+            DropOnOverflow = 0,
+            /** Wait until the engine made room in the lane. Callers from
+             * the engine's own thread or an inactive engine fall back to
+             * DropOnOverflow. */
+            BlockOnOverflow,
+            /** Store the message in an unbounded, locked secondary queue
+             * which the engine moves into the lane as room becomes available.
+             * This allocates memory and is thus only for non real-time callers. */
+            SpillOnOverflow
+        };
+
         /**
          * Create an execution engine with a internal::CommandProcessor, scripting::ProgramProcessor
          * and StateMachineProcessor.
@@ -121,6 +150,17 @@ namespace RTT
          */
         virtual bool process(base::DisposableInterface* c);
 
+        /**
+         * Queue and execute (process) a given message in a given lane.
+         * The message is executed in step() or loop() after all messages
+         * of the higher lanes and after the messages queued earlier in the
+         * same lane.
+         * @param c The message to execute.
+         * @param lane The priority lane to queue \a c in.
+         * @return true if the message got accepted, false otherwise.
+         */
+        bool process(base::DisposableInterface* c, Lane lane);
+
         /**
          * Run a given function in step() or loop(). The function may only
          * be destroyed after the
@@ -131,6 +171,15 @@ namespace RTT
          */
         virtual bool runFunction(base::ExecutableInterface* f);
 
+        /**
+         * Run a given function in step() or loop() in a given lane.
+         * @param f The function to run.
+         * @param lane The priority lane in which \a f is run.
+         * @return false if the Engine is not running or more functions
+         * were started in \a lane since the last step than its capacity.
+         */
+        bool runFunction(base::ExecutableInterface* f, Lane lane);
+
         /**
          * Remove a running function added with runFunction.
          * This method is only required if the function is to be destroyed
@@ -182,6 +231,199 @@ namespace RTT
          * Set the 'owner' task in the exception state.
          */
         void setExceptionTask();
+
+        /**
+         * The maximum number of messages that processMessages() dequeues
+         * in one atomic operation.
+         */
+        static const unsigned int MAX_MESSAGE_BATCH = 16;
+
+        /**
+         * Counters about the batches of messages processed by this engine.
+         * They are only written by the thread executing this engine and
+         * are meant for inspection, not for synchronisation.
+         */
+        struct MessageStatistics
+        {
+            MessageStatistics() : batches(0), messages(0), max_batch(0), last_batch(0) {}
+            /** The number of batches dequeued from the message queue. */
+            unsigned long batches;
+            /** The total number of messages dequeued from the message queue. */
+            unsigned long messages;
+            /** The largest batch size observed. */
+            unsigned int max_batch;
+            /** The size of the most recently dequeued batch. */
+            unsigned int last_batch;
+        };
+
+        /**
+         * Sets the maximum number of messages that are dequeued at once
+         * in processMessages(). A value of 1 dequeues the messages one
+         * by one.
+         * @param n A number between 1 and MAX_MESSAGE_BATCH.
+         * @return false if \a n is out of range.
+         */
+        bool setMessageBatchSize(unsigned int n);
+
+        /**
+         * Returns the maximum number of messages that are dequeued at once.
+         */
+        unsigned int getMessageBatchSize() const;
+
+        /**
+         * Returns a copy of the message batch counters of this engine.
+         */
+        MessageStatistics getMessageStatistics() const;
+
+        /**
+         * Resets the message batch counters to zero.
+         */
+        void resetMessageStatistics();
+
+        /**
+         * Limits the number of messages and the number of functions
+         * that are executed from \a lane in each step(). The
+         * remaining messages are executed in the next step().
+         * @param lane The lane to limit.
+         * @param budget The maximum number of messages and functions
+         * executed from \a lane per step, or zero for no limit (the default).
+         */
+        void setLaneBudget(Lane lane, unsigned int budget);
+
+        /**
+         * Returns the per-step budget of \a lane, zero if unlimited.
+         */
+        unsigned int getLaneBudget(Lane lane) const;
+
+        /**
+         * Sets the number of messages that can be queued in \a lane,
+         * and the number of functions that can be started in it between
+         * two steps. The number of running functions is not limited.
+         * This may be done while the
+         * engine is running: the queued messages and functions are
+         * kept and the engine's thread is never blocked, but the
+         * calling thread waits for concurrent process() calls to finish,
+         * so do not call this from a real-time thread.
+         * @param lane The lane to resize.
+         * @param capacity The new capacity, must be at least 1.
+         * @return false if \a capacity is zero or the engine did not yet
+         * empty the queues of a previous resize of this lane.
+         */
+        bool setLaneCapacity(Lane lane, unsigned int capacity);
+
+        /**
+         * Returns the number of messages that can be queued in \a lane.
+         */
+        unsigned int getLaneCapacity(Lane lane) const;
+
+        /**
+         * Sets what process() does when the message queue of \a lane
+         * is full. Functions are always rejected when their lane is full.
+         */
+        void setLaneOverflowPolicy(Lane lane, OverflowPolicy policy);
+
+        /**
+         * Returns the overflow policy of \a lane.
+         */
+        OverflowPolicy getLaneOverflowPolicy(Lane lane) const;
+
+        /**
+         * Counters about the load of a lane.
+         */
+        struct LaneStatistics
+        {
+            LaneStatistics() : high_water(0), drops(0), spills(0), blocks(0) {}
+            /** The largest number of messages that was found in the lane
+             * at the start of processing it. */
+            unsigned int high_water;
+            /** The number of messages and functions rejected because the lane was full. */
+            unsigned int drops;
+            /** The number of messages that went to the secondary queue. */
+            unsigned int spills;
+            /** The number of process() calls that had to wait for room in the lane. */
+            unsigned int blocks;
+        };
+
+        /**
+         * Returns a copy of the load counters of \a lane.
+         */
+        LaneStatistics getLaneStatistics(Lane lane) const;
+
+        /**
+         * Resets the load counters of \a lane to zero.
+         */
+        void resetLaneStatistics(Lane lane);
+
+        /**
+         * Sets the lane in which the messages that this engine sends
+         * to other engines are queued, for example when an operation
+         * is sent or called from the component owning this engine.
+         * The default is NormalLane.
+         */
+        void setSendLane(Lane lane);
+
+        /**
+         * Returns the lane in which this engine sends its messages.
+         */
+        Lane getSendLane() const { return send_lane; }
+
+        /**
+         * The parts of step() timed by the cycle profiler.
+         * CycleJitter is the deviation of the time between the start
+         * of two steps from the period of a periodic activity.
+         * @see setProfiling
+         */
+        enum ProfilePhase { MessagesPhase = 0, FunctionsPhase, UpdatePhase, CycleJitter, ProfilePhaseCount };
+
+        /**
+         * The number of histogram buckets of a PhaseStatistics.
+         */
+        static const unsigned int PROFILE_BUCKETS = 16;
+
+        /**
+         * Timing statistics of one ProfilePhase, in nanoseconds.
+         */
+        struct PhaseStatistics
+        {
+            PhaseStatistics() : count(0), min(0), max(0), total(0)
+            {
+                for (unsigned int i = 0; i != PROFILE_BUCKETS; ++i)
+                    histogram[i] = 0;
+            }
+            /** The number of samples. */
+            unsigned long count;
+            nsecs min;
+            nsecs max;
+            /** The sum of all samples, divide by count for the mean. */
+            nsecs total;
+            /** Bucket 0 counts the samples below 1us, bucket i the samples
+             * below 2^i us and the last bucket all the longer ones. */
+            unsigned int histogram[PROFILE_BUCKETS];
+        };
+
+        /**
+         * Enables or disables timing the phases of step(). It is disabled
+         * by default, which costs one test per step. When enabled, each
+         * step reads the clock four times, but never allocates or blocks.
+         */
+        void setProfiling(bool on);
+
+        /**
+         * Returns true if the phases of step() are timed.
+         */
+        bool isProfiling() const { return profiling; }
+
+        /**
+         * Returns a consistent copy of the statistics of \a phase.
+         * They are published after each step, unless this function
+         * was copying them at that moment.
+         */
+        PhaseStatistics getPhaseStatistics(ProfilePhase phase) const;
+
+        /**
+         * Clears all profile statistics at the start of the next step.
+         */
+        void resetProfile();
     protected:
         /**
          * Call this if you wish to block on a message arriving in the Execution Engine.
@@ -232,20 +474,145 @@ namespace RTT
         base::TaskCore*     taskc;
 
         /**
-         * Our Message queue
+         * Our Message queues, one for each Lane.
          */
-        internal::MWSRQueue<base::DisposableInterface*>* mqueue;
+        internal::ResizableMWSRQueue<base::DisposableInterface*>* mqueue[LaneCount];
 
         std::vector<base::TaskCore*> children;
 
         /**
-         * Stores all functions we're executing.
+         * Hands over the functions of runFunction() to our thread,
+         * one queue for each Lane.
+         */
+        internal::ResizableMWSRQueue<base::ExecutableInterface*>* f_queue[LaneCount];
+
+        /**
+         * The functions we're executing, an intrusive list for each
+         * Lane which is only accessed by our thread. Functions are
+         * taken from the head, executed and appended to the tail again.
+         */
+        base::ExecutableInterface* f_head[LaneCount];
+        base::ExecutableInterface* f_tail[LaneCount];
+        unsigned int f_count[LaneCount];
+
+        /**
+         * The functions that are being executed, innermost first.
+         * A function removed during its own execute() is marked
+         * here, such that it is not appended to the run list again.
+         */
+        struct RunningFunction {
+            base::ExecutableInterface* f;
+            bool removed;
+            RunningFunction* up;
+        };
+        RunningFunction* f_running;
+
+        /**
+         * Moves the functions handed over in \a lane to its run list.
+         */
+        void adoptFunctions(int lane);
+
+        /**
+         * Appends \a f to the run list of \a lane.
+         */
+        void linkFunction(base::ExecutableInterface* f, int lane);
+
+        /**
+         * Removes \a f from the run list it is linked in.
+         */
+        void unlinkFunction(base::ExecutableInterface* f);
+
+        /**
+         * The maximum number of messages and functions executed
+         * per step in each Lane, zero if unlimited.
          */
-        internal::MWSRQueue<base::ExecutableInterface*>* f_queue;
+        unsigned int lane_budget[LaneCount];
+
+        /**
+         * The Lane in which our own messages are sent to other engines.
+         */
+        Lane send_lane;
+
+        OverflowPolicy lane_policy[LaneCount];
+
+        /**
+         * Serialises setLaneCapacity(), such that both queues
+         * of a lane are always resized together.
+         */
+        os::Mutex capacity_lock;
+
+        /**
+         * The messages that overflowed a lane with the SpillOnOverflow
+         * policy, guarded by spill_lock and counted in spill_count.
+         */
+        std::deque<base::DisposableInterface*> spill[LaneCount];
+        os::Mutex spill_lock[LaneCount];
+        os::AtomicInt spill_count[LaneCount];
+
+        /**
+         * Lane load counters. high_water is only written by the
+         * thread executing this engine. The others are mutable
+         * since reading an os::AtomicInt is not const.
+         */
+        unsigned int lane_high_water[LaneCount];
+        mutable os::AtomicInt lane_drops[LaneCount];
+        mutable os::AtomicInt lane_spills[LaneCount];
+        mutable os::AtomicInt lane_blocks[LaneCount];
+
+        /**
+         * Handles a message that could not be queued in \a lane,
+         * according to the lane's OverflowPolicy.
+         */
+        bool overflow(base::DisposableInterface* c, Lane lane);
+
+        /**
+         * Moves spilled messages of \a lane back into its queue,
+         * without blocking.
+         * @return true if at least one message was moved.
+         */
+        bool unspill(Lane lane);
 
         os::Mutex msg_lock;
         os::Condition msg_cond;
 
+        /**
+         * The number of threads blocking on msg_cond. Only modified
+         * while holding msg_lock, such that processMessages() can
+         * skip the lock and broadcast if no-one is waiting.
+         */
+        os::AtomicInt msg_waiters;
+
+        /**
+         * The messages that were dequeued, but not yet executed.
+         * These are members such that a recursive processMessages()
+         * continues where the outer one was and preserves the order.
+         */
+        base::DisposableInterface* mbatch[MAX_MESSAGE_BATCH];
+        unsigned int mbatch_next, mbatch_count, mbatch_size;
+        MessageStatistics mstats;
+
+        /**
+         * The cycle profiler. profile is only used by our thread, which
+         * copies it to profile_pub if it gets profile_lock without waiting.
+         */
+        volatile bool profiling;
+        volatile bool profile_reset;
+        volatile bool profile_restart;
+        nsecs profile_last_start;
+        PhaseStatistics profile[ProfilePhaseCount];
+        PhaseStatistics profile_pub[ProfilePhaseCount];
+        mutable os::Mutex profile_lock;
+
+        /**
+         * Adds one sample to the statistics of \a phase.
+         */
+        void addProfileSample(ProfilePhase phase, nsecs sample);
+
+        /**
+         * Wakes up all threads waiting on msg_cond, but only if there are any.
+         */
+        void signalWaiters();
+
         void processMessages();
         void processFunctions();
         void processChildren();
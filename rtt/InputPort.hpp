@@ -44,6 +44,7 @@
 #include "internal/InputPortSource.hpp"
 #include "Service.hpp"
 #include "OperationCaller.hpp"
+#include <limits>
 
 #include "OutputPort.hpp"
 
@@ -84,6 +85,14 @@ namespace RTT
             return false;
         }
 
+        bool do_read_batch(std::vector<T>& samples, int max, bool, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            if ( input )
+                return input->readBatch(samples, max) != 0;
+            return false;
+        }
+
         /**
          * You are not allowed to copy ports.
          * In case you want to create a container of ports,
@@ -173,6 +182,32 @@ namespace RTT
             return RTT::NewData;
         }
 
+        /** Reads at most \a max new samples from the connection in one batch.
+         * \a samples is cleared and then filled with the new samples, oldest
+         * first. Buffered connections return all samples at once, data connections
+         * return at most one sample. Old data is never returned.
+         *
+         * @return the number of samples stored in \a samples.
+         */
+        int readBatch(std::vector<T>& samples, int max)
+        {
+            samples.clear();
+            if ( max <= 0 )
+                return 0;
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_batch, this, boost::ref(samples), max, boost::lambda::_1, boost::lambda::_2), false );
+            return samples.size();
+        }
+
+        /** Reads all new samples that are available on the current
+         * connection, oldest first.
+         * @see readBatch
+         * @return the number of samples stored in \a samples.
+         */
+        int readAll(std::vector<T>& samples)
+        {
+            return readBatch(samples, std::numeric_limits<int>::max());
+        }
+
         /**
          * Get a sample of the data on this port, without actually reading the port's data.
          * It's the complement of OutputPort::setDataSample() and serves to retrieve the size
@@ -183,7 +218,7 @@ namespace RTT
          */
         void getDataSample(T& sample)
         {
-            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( cmanager.getCurrentChannel() );
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( cmanager.getCurrentChannel().get() );
             if ( input ) {
                 sample = input->data_sample();
             }
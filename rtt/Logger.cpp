@@ -59,9 +59,21 @@
 #endif
 
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include "rtt-config.h"
 #include "rtt-fwd.hpp"
 
+// Asynchronous logging needs thread local storage.
+#if defined(__GNUC__) && !defined(OROBLD_DISABLE_LOGGING)
+#  define ORO_LOGGER_ASYNC
+#  include "os/Thread.hpp"
+#  include "os/threads.hpp"
+#  include "os/CAS.hpp"
+#  include "os/Atomic.hpp"
+#  include "base/BufferSPSC.hpp"
+#endif
+
 namespace RTT
 {
     using namespace std;
@@ -94,6 +106,75 @@ namespace RTT
         return Instance()->operator<<( ll );
     }
 
+#ifdef ORO_LOGGER_ASYNC
+    namespace {
+        /**
+         * One line of an asynchronous log message.
+         */
+        struct LogRecord
+        {
+            enum { ModuleSize = 32, TextSize = 216 };
+            TimeService::ticks time;
+            Logger::LogLevel level;
+            int length;
+            char module[ModuleSize];
+            char text[TextSize];
+        };
+
+        /**
+         * The asynchronous logging state of one thread. The stream formats
+         * into \a record, which is queued in \a ring when the line ends.
+         * The thread is the only writer of the ring, the flusher thread
+         * the only reader.
+         */
+        struct ThreadLog : public std::streambuf
+        {
+            enum { RingSize = 128 };
+
+            ThreadLog()
+                : ring(RingSize), stream(this), level(Logger::Info), discard(false), next(0)
+            {
+                record.length = 0;
+                strncpy(module, "Logger", LogRecord::ModuleSize);
+            }
+
+            base::BufferSPSC<LogRecord> ring;
+            LogRecord record;
+            std::ostream stream;
+            Logger::LogLevel level;
+            /** True if messages of \a level are not logged at all. */
+            bool discard;
+            char module[LogRecord::ModuleSize];
+            os::AtomicInt dropped;
+            ThreadLog* next;
+
+        protected:
+            int overflow(int c) {
+                if ( c != traits_type::eof() && !discard && record.length < LogRecord::TextSize )
+                    record.text[record.length++] = traits_type::to_char_type(c);
+                return traits_type::not_eof(c);
+            }
+
+            std::streamsize xsputn(const char* str, std::streamsize n) {
+                if ( discard )
+                    return n;
+                std::streamsize len = std::min<std::streamsize>(n, LogRecord::TextSize - record.length);
+                memcpy(record.text + record.length, str, len);
+                record.length += len;
+                return n;
+            }
+        };
+
+        /**
+         * The ThreadLog of the current thread and the Logger instance it
+         * belongs to, such that a new Logger does not reuse a deleted one.
+         */
+        __thread ThreadLog* tls_log = 0;
+        __thread unsigned int tls_generation = 0;
+        unsigned int logger_generation = 0;
+    }
+#endif
+
     /**
      * This hidden struct stores all data structures required for logging.
      */
@@ -116,6 +197,9 @@ namespace RTT
               started(false), showtime(true), allowRT(false),
               mlogStdOut(true), mlogFile(true),
               moduleptr("Logger")
+#ifdef ORO_LOGGER_ASYNC
+              , async(false), generation(++logger_generation), threadlogs(0), flusher(0)
+#endif
         {
 #if defined(OROSEM_FILE_LOGGING) && defined(OROSEM_PRINTF_LOGGING)
             logfile = fopen(logfile_name ? logfile_name : "orocos.log","w");
@@ -129,13 +213,21 @@ namespace RTT
         }
 
         bool maylogStdOut() const {
-            if ( inloglevel <= outloglevel && outloglevel != Never && inloglevel != Never && mlogStdOut)
+            return maylogStdOut( inloglevel );
+        }
+
+        bool maylogStdOut(LogLevel ll) const {
+            if ( ll <= outloglevel && outloglevel != Never && ll != Never && mlogStdOut)
                 return true;
             return false;
         }
 
         bool maylogFile() const {
-            if ( (inloglevel <= Info || inloglevel <= outloglevel)  && mlogFile)
+            return maylogFile( inloglevel );
+        }
+
+        bool maylogFile(LogLevel ll) const {
+            if ( (ll <= Info || ll <= outloglevel)  && mlogFile)
                 return true;
             return false;
         }
@@ -185,6 +277,136 @@ namespace RTT
             }
         }
 
+#ifdef ORO_LOGGER_ASYNC
+        /**
+         * Returns the ThreadLog of the calling thread, creating it on
+         * the first message of that thread.
+         */
+        ThreadLog* threadLog() {
+            if ( tls_log && tls_generation == generation )
+                return tls_log;
+            ThreadLog* tl = new ThreadLog();
+            tl->level = inloglevel;
+            tl->discard = !maylogStdOut(tl->level) && !maylogFile(tl->level);
+            do {
+                tl->next = threadlogs;
+            } while ( !os::CAS(&threadlogs, tl->next, tl) );
+            tls_log = tl;
+            tls_generation = generation;
+            return tl;
+        }
+
+        /**
+         * Queues the current record of the calling thread for the flusher
+         * thread, unless asynchronous logging is being stopped.
+         * @return false if the caller must log synchronously.
+         */
+        bool tryCommit() {
+            // stopAsync() waits until no thread is committing anymore.
+            committers.inc();
+            bool result = async;
+            if ( result )
+                commit( threadLog() );
+            committers.dec();
+            return result;
+        }
+
+        /**
+         * Queues the current record of \a tl for the flusher thread.
+         */
+        void commit(ThreadLog* tl) {
+            if ( !tl->discard ) {
+                tl->record.time = TimeService::Instance()->getTicks();
+                tl->record.level = tl->level;
+                memcpy(tl->record.module, tl->module, LogRecord::ModuleSize);
+                if ( !tl->ring.Push(tl->record) )
+                    tl->dropped.inc();
+            }
+            tl->record.length = 0;
+            tl->stream.clear();
+        }
+
+        /**
+         * Writes out all queued records. Called by the flusher thread and
+         * by stopAsync().
+         */
+        void flushRecords() {
+            os::MutexLock lock( inpguard );
+            for (ThreadLog* tl = threadlogs; tl; tl = tl->next) {
+                LogRecord* rec;
+                while ( (rec = tl->ring.PopWithoutRelease()) ) {
+                    std::string res = showTime(rec->time) + " " + showLevel(rec->level) + "[" + rec->module + "] ";
+                    std::string line(rec->text, rec->length);
+                    LogLevel ll = rec->level;
+                    tl->ring.Release(rec);
+                    if ( maylogStdOut(ll) ) {
+#ifndef OROSEM_PRINTF_LOGGING
+                        *stdoutput << res << line << Logger::nl;
+#else
+                        printf("%s%s\n", res.c_str(), line.c_str() );
+#endif
+                    }
+#ifdef OROSEM_FILE_LOGGING
+                    if ( maylogFile(ll) ) {
+#ifndef OROSEM_PRINTF_LOGGING
+                        logfile << res << line << Logger::nl;
+#else
+                        fprintf( logfile, "%s%s\n", res.c_str(), line.c_str() );
+#endif
+#ifdef OROSEM_REMOTE_LOGGING
+                        if ( messagecnt >= ORONUM_LOGGING_BUFSIZE ) {
+                            std::string dummy;
+                            remotestream >> dummy; // FIFO principle: read 1 line
+                            --messagecnt;
+                        }
+                        remotestream << res << line << Logger::nl;
+                        ++messagecnt;
+#endif
+                    }
+#endif
+                }
+            }
+#ifndef OROSEM_PRINTF_LOGGING
+            stdoutput->flush();
+#if defined(OROSEM_FILE_LOGGING)
+            logfile.flush();
+#endif
+#endif
+        }
+
+        /**
+         * Periodically writes out the queued records.
+         */
+        struct Flusher : public os::Thread
+        {
+            D* d;
+            Flusher(D* owner, Seconds period)
+                : os::Thread(ORO_SCHED_OTHER, os::LowestPriority, period, ~0, "LogFlusher"), d(owner)
+            {}
+            ~Flusher() { stop(); }
+            void step() { d->flushRecords(); }
+        };
+
+        /** True while records are queued instead of written directly. */
+        volatile bool async;
+        /** The number of threads in tryCommit(). */
+        os::AtomicInt committers;
+        /** Distinguishes the ThreadLogs of this instance from earlier ones. */
+        unsigned int generation;
+        /** All ThreadLogs, one for each thread that logged asynchronously. */
+        ThreadLog* volatile threadlogs;
+        Flusher* flusher;
+
+        ~D() {
+            delete flusher;
+            while ( threadlogs ) {
+                ThreadLog* tl = threadlogs;
+                threadlogs = tl->next;
+                delete tl;
+            }
+        }
+#endif
+
 #ifndef OROSEM_PRINTF_LOGGING
         std::ostream* stdoutput;
 #endif
@@ -238,6 +460,14 @@ namespace RTT
             return time.str();
         }
 
+        std::string showTime(TimeService::ticks t) const
+        {
+            std::stringstream time;
+            if ( showtime )
+                time <<fixed<< showpoint << setprecision(3) << Seconds(TimeService::ticks2nsecs(t - timestamp))/NSECS_IN_SECS;
+            return time.str();
+        }
+
         /**
          * Convert a loglevel to a string representation.
          */
@@ -383,6 +613,13 @@ namespace RTT
 
     Logger& Logger::in(const std::string& modname)
     {
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async ) {
+            // the module is tracked per thread, such that no lock is needed.
+            strncpy( d->threadLog()->module, modname.c_str(), LogRecord::ModuleSize - 1 );
+            return *this;
+        }
+#endif
         os::MutexLock lock( d->inpguard );
         d->moduleptr = modname.c_str();
         return *this;
@@ -390,12 +627,22 @@ namespace RTT
 
     Logger& Logger::out(const std::string& oldmod)
     {
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async ) {
+            strncpy( d->threadLog()->module, oldmod.c_str(), LogRecord::ModuleSize - 1 );
+            return *this;
+        }
+#endif
         os::MutexLock lock( d->inpguard );
         d->moduleptr = oldmod.c_str();
         return *this;
     }
 
     std::string Logger::getLogModule() const {
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async )
+            return d->threadLog()->module;
+#endif
         os::MutexLock lock( d->inpguard );
         std::string ret = d->moduleptr.c_str();
         return ret;
@@ -459,6 +706,7 @@ namespace RTT
         if (!d->started)
             return;
         *this<<Logger::Info<<"Orocos Logging Deactivated." << Logger::endl;
+        this->stopAsync();
         this->logflush();
         d->started = false;
     }
@@ -492,6 +740,11 @@ namespace RTT
         if ( !d->maylog() )
             return *this;
 
+        if ( std::ostream* as = asyncStream() ) {
+            *as << t;
+            return *this;
+        }
+
         os::MutexLock lock( d->inpguard );
         if ( d->maylogStdOut() )
             d->logline << t;
@@ -511,6 +764,14 @@ namespace RTT
     Logger& Logger::operator<<(LogLevel ll) {
         if ( !d->maylog() )
             return *this;
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async ) {
+            ThreadLog* tl = d->threadLog();
+            tl->level = ll;
+            tl->discard = !d->maylogStdOut(ll) && !d->maylogFile(ll);
+            return *this;
+        }
+#endif
         d->inloglevel = ll;
         return *this;
     }
@@ -525,6 +786,8 @@ namespace RTT
             this->lognl();
         else if ( pf == Logger::flush )
             this->logflush();
+        else if ( std::ostream* as = asyncStream() )
+            *as << pf;
         else {
             os::MutexLock lock( d->inpguard );
             if ( d->maylogStdOut() )
@@ -538,7 +801,7 @@ namespace RTT
     }
 
     void Logger::logflush() {
-        if (!d->maylog())
+        if (!d->maylog() || isAsync())
             return;
         {
             // just flush all buffers, do not produce a new logline
@@ -564,12 +827,20 @@ namespace RTT
     void Logger::lognl() {
         if (!d->maylog())
             return;
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async && d->tryCommit() )
+            return;
+#endif
         d->logit( Logger::nl );
      }
 
     void Logger::logendl() {
         if (!d->maylog())
             return;
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async && d->tryCommit() )
+            return;
+#endif
         d->logit( Logger::endl );
      }
 
@@ -581,6 +852,69 @@ namespace RTT
         return d->outloglevel ;
     }
 
+    std::ostream* Logger::asyncStream() {
+#ifdef ORO_LOGGER_ASYNC
+        if ( d->async )
+            return &d->threadLog()->stream;
+#endif
+        return 0;
+    }
+
+    bool Logger::startAsync(Seconds period) {
+#ifdef ORO_LOGGER_ASYNC
+        if ( !d->started || d->async )
+            return d->async;
+        if ( period <= 0 ) {
+            *this << Logger::Error << "Can not log asynchronously with a flush period of " << period << " seconds." << Logger::endl;
+            return false;
+        }
+        *this << Logger::Info << "Switching to asynchronous logging." << Logger::endl;
+        d->flusher = new D::Flusher(d, period);
+        d->async = true;
+        d->flusher->start();
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void Logger::stopAsync() {
+#ifdef ORO_LOGGER_ASYNC
+        if ( !d->async )
+            return;
+        // new records are logged synchronously from now on, wait for
+        // the ones that are being queued before the final flush.
+        d->async = false;
+        oro_mb();
+        while ( d->committers.read() != 0 ) {
+            TIME_SPEC ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 100*1000;
+            rtos_nanosleep( &ts, 0 );
+        }
+        delete d->flusher;
+        d->flusher = 0;
+        d->flushRecords();
+#endif
+    }
+
+    bool Logger::isAsync() const {
+#ifdef ORO_LOGGER_ASYNC
+        return d->async;
+#else
+        return false;
+#endif
+    }
+
+    unsigned int Logger::getDroppedMessages() const {
+        unsigned int dropped = 0;
+#ifdef ORO_LOGGER_ASYNC
+        for (ThreadLog* tl = d->threadlogs; tl; tl = tl->next)
+            dropped += tl->dropped.read();
+#endif
+        return dropped;
+    }
+
 
 #else // OROBLD_DISABLE_LOGGING
 
@@ -311,7 +311,47 @@ namespace RTT
          */
         void lognl();
 
+        /**
+         * Switch to asynchronous logging. From then on, each thread formats
+         * its messages into fixed size records, which are queued in a
+         * lock-free ring owned by that thread. A background thread writes
+         * the records to the output streams every \a period seconds.
+         * Logging then no longer takes a lock nor does file I/O in the
+         * calling thread, and only allocates memory for the first message
+         * of each thread. Lines longer than a record are truncated and
+         * messages that do not fit in the ring are dropped.
+         * @param period The period of the background thread, in seconds.
+         * Must be larger than zero.
+         * @return false if asynchronous logging is not supported on this
+         * platform, logging was not started or \a period is not positive.
+         * @see getDroppedMessages()
+         */
+        bool startAsync(Seconds period = 0.01);
+
+        /**
+         * Write out all pending records, stop the background thread and
+         * return to synchronous logging.
+         */
+        void stopAsync();
+
+        /**
+         * Returns true if startAsync() was called and stopAsync() not yet.
+         */
+        bool isAsync() const;
+
+        /**
+         * Returns the number of messages that were dropped because the ring
+         * of the logging thread was full.
+         */
+        unsigned int getDroppedMessages() const;
+
     private:
+        /**
+         * Returns the stream of the current thread if logging is
+         * asynchronous, zero otherwise.
+         */
+        std::ostream* asyncStream();
+
         /**
          * Returns true if the next message will be logged.
          * Returns false if the LogLevel is RealTime and
@@ -17,6 +17,11 @@ namespace RTT
         if ( !mayLog() )
             return *this;
 
+        if ( std::ostream* as = asyncStream() ) {
+            *as << t;
+            return *this;
+        }
+
         os::MutexLock lock( inpguard );
         if ( this->mayLogStdOut() )
             logline << t;
@@ -139,6 +144,21 @@ namespace RTT
     inline Logger::LogLevel Logger::getLogLevel() const {
         return Never;
     }
+
+    inline bool Logger::startAsync(Seconds) {
+        return false;
+    }
+
+    inline void Logger::stopAsync() {
+    }
+
+    inline bool Logger::isAsync() const {
+        return false;
+    }
+
+    inline unsigned int Logger::getDroppedMessages() const {
+        return 0;
+    }
 #endif
 
 }
@@ -70,12 +70,25 @@ namespace RTT
     class OutputPort : public base::OutputPortInterface
     {
         friend class internal::ConnInputEndpoint<T>;
+        friend class internal::ConnFactory;
 
-        bool do_write(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        bool do_write(typename base::ChannelElement<T>::param_t sample, bool& shared_written, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
                 = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
-            if (output->write(sample))
+            if ( descriptor.get<2>().type == ConnPolicy::SHARED_DATA ) {
+                // the sample is copied once for all shared connections,
+                // the readers only need to be notified.
+                if ( !shared_written ) {
+                    shared_data->write(sample);
+                    shared_written = true;
+                }
+                if (output->signal())
+                    return false;
+                log(Error) << "A channel of port " << getName() << " has been invalidated during write(), it will be removed" << endlog();
+                return true;
+            }
+            else if (output->write(sample))
                 return false;
             else
             {
@@ -84,6 +97,19 @@ namespace RTT
             }
         }
 
+        bool do_write_batch(const std::vector<T>& samples, bool& shared_written, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            // shared connections only keep the last sample.
+            if ( descriptor.get<2>().type == ConnPolicy::SHARED_DATA )
+                return do_write(samples.back(), shared_written, descriptor);
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            if (output->writeBatch(samples))
+                return false;
+            log(Error) << "A channel of port " << getName() << " has been invalidated during writeBatch(), it will be removed" << endlog();
+            return true;
+        }
+
         bool do_init(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
@@ -135,6 +161,9 @@ namespace RTT
         // This is used to allow the use of the 'init' connection policy option
         bool keeps_last_written_value;
         typename base::DataObjectInterface<T>::shared_ptr sample;
+        /// The sample shared by all ConnPolicy::SHARED_DATA connections.
+        // Created by the ConnFactory with the first such connection.
+        typename internal::SharedDataStorage<T>::shared_ptr shared_data;
 
         /**
          * You are not allowed to copy ports.
@@ -252,8 +281,36 @@ namespace RTT
             }
             has_last_written_value = keeps_last_written_value;
 
+            bool shared_written = false;
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write, this, boost::ref(sample), boost::ref(shared_written), boost::lambda::_1)
+                    );
+        }
+
+        /**
+         * Writes a batch of samples to all receivers (if any), oldest first.
+         * Each connection receives the batch in one call, such that buffered
+         * connections store it at once instead of sample per sample. Data
+         * connections only receive the last sample of the batch.
+         * This function is not an overload of write() since \a T may be a
+         * std::vector itself.
+         * @param samples The new samples to send out.
+         */
+        void writeBatch(const std::vector<T>& samples)
+        {
+            if ( samples.empty() )
+                return;
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(samples.back());
+            }
+            has_last_written_value = keeps_last_written_value;
+
+            bool shared_written = false;
             cmanager.delete_if( boost::bind(
-                        &OutputPort<T>::do_write, this, boost::ref(sample), boost::lambda::_1)
+                        &OutputPort<T>::do_write_batch, this, boost::ref(samples), boost::ref(shared_written), boost::lambda::_1)
                     );
         }
 
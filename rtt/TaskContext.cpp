@@ -50,6 +50,7 @@
 #include "internal/DataSource.hpp"
 #include "internal/mystd.hpp"
 #include "internal/MWSRQueue.hpp"
+#include "internal/FusedFunctorDataSource.hpp"
 #include "OperationCaller.hpp"
 
 #include "rtt-config.h"
@@ -118,6 +119,22 @@ namespace RTT
 
         this->addOperation("trigger", &TaskContext::trigger, this, ClientThread).doc("Trigger the update method for execution in the thread of this task.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
         this->addOperation("loadService", &TaskContext::loadService, this, ClientThread).doc("Loads a service known to RTT into this component.").arg("service_name","The name with which the service is registered by in the PluginLoader.");
+        this->addOperation("setLaneCapacity", &TaskContext::setLaneCapacity, this, ClientThread).doc("Set the number of messages and functions that can be queued in a lane of the Execution Engine.").arg("lane", "0: critical, 1: normal, 2: background.").arg("capacity", "The new capacity, at least 1.");
+        this->addOperation("setLaneOverflowPolicy", &TaskContext::setLaneOverflowPolicy, this, ClientThread).doc("Set what happens with messages sent to a full lane of the Execution Engine.").arg("lane", "0: critical, 1: normal, 2: background.").arg("policy", "0: drop, 1: block the sender, 2: spill to a secondary queue.");
+        this->addOperation("setCycleProfiling", &TaskContext::setCycleProfiling, this, ClientThread).doc("Enable or disable timing each step of the Execution Engine.").arg("on", "True to enable.");
+        this->addOperation("resetCycleProfile", &TaskContext::resetCycleProfile, this, ClientThread).doc("Clear the timing statistics of the Execution Engine.");
+        this->addOperation("getCycleProfile", &TaskContext::getCycleProfile, this, ClientThread).doc("Get the timing statistics of a phase of each step: count, min, max and mean in seconds, followed by the histogram counts (below 1us, 2us, 4us, ...).").arg("phase", "0: messages, 1: functions, 2: updateHook, 3: jitter of the period.");
+
+        // the lane counters are read-only, and evaluated on the current engine.
+        const char* lanes[ExecutionEngine::LaneCount] = { "CriticalLane", "NormalLane", "BackgroundLane" };
+        for (int lane = 0; lane != ExecutionEngine::LaneCount; ++lane) {
+            Alias hw( std::string(lanes[lane]) + "HighWater",
+                      new internal::FusedFunctorDataSource<unsigned int(void)>( boost::bind(&TaskCore::getLaneHighWater, this, lane) ) );
+            this->addAttribute( hw );
+            Alias drops( std::string(lanes[lane]) + "Drops",
+                         new internal::FusedFunctorDataSource<unsigned int(void)>( boost::bind(&TaskCore::getLaneDrops, this, lane) ) );
+            this->addAttribute( drops );
+        }
         // activity runs from the start.
         if (our_act)
             our_act->start();
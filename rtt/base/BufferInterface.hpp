@@ -85,6 +85,17 @@ namespace RTT
          */
         virtual size_type Pop( std::vector<value_t>& items ) = 0;
 
+        /**
+         * Read at most \a max values from the buffer in one batch.
+         * @param items is to be filled with the values read,
+         * with \a items.begin() the oldest value.
+         * @param max The maximum number of values to read.
+         * @return the number of items read.
+         * @cts
+         * @rt
+         */
+        virtual size_type Pop( std::vector<value_t>& items, size_type max ) = 0;
+
 	/**
 	 * Returns a pointer to the first element in the buffer.
 	 * The pointer is only garanteed to stay valid until 
@@ -75,6 +75,11 @@ namespace RTT
         typedef T value_t;
     private:
         typedef T Item;
+        /**
+         * The number of items moved in one step between the
+         * pool and the queue by the batched Push and Pop functions.
+         */
+        enum { BatchSize = 16 };
         internal::AtomicMWSRQueue<Item*> bufs;
         // is mutable because of reference counting.
         mutable internal::TsPool<Item> mpool;
@@ -180,17 +185,36 @@ namespace RTT
 
         size_type Push(const std::vector<T>& items)
         {
-            // @todo Make this function more efficient as in BufferLocked.
-            int towrite  = items.size();
-            typename std::vector<T>::const_iterator it;
-            for(  it = items.begin(); it != items.end(); ++it)
-                if ( this->Push( *it ) == false ) {
-                    break; // will only happen in non-circular case !
+            // Fill chunks of items from the pool and enqueue each chunk
+            // with a single atomic operation on the queue.
+            Item* chunk[BatchSize];
+            typename std::vector<T>::const_iterator it = items.begin();
+            while ( it != items.end() ) {
+                size_type n = 0;
+                while ( n != BatchSize && it + n != items.end() ) {
+                    Item* mitem = mpool.allocate();
+                    if ( mitem == 0 )
+                        break;
+                    *mitem = *(it + n);
+                    chunk[n++] = mitem;
+                }
+                size_type written = bufs.enqueue( chunk, n );
+                it += written;
+                if ( written != n || n == 0 ) {
+                    // buffer or pool full: return what we did not write.
+                    for ( size_type i = written; i != n; ++i )
+                        mpool.deallocate( chunk[i] );
+                    break;
                 }
-            return towrite - (items.end() - it);
+            }
+            // in the circular case, the remaining items replace
+            // the oldest ones, one at a time.
+            if ( mcircular )
+                while ( it != items.end() && this->Push( *it ) )
+                    ++it;
+            return it - items.begin();
         }
 
-
         bool Pop( reference_t item )
         {
             Item* ipop;
@@ -214,6 +238,24 @@ namespace RTT
             return items.size();
         }
         
+        size_type Pop(std::vector<T>& items, size_type max )
+        {
+            Item* chunk[BatchSize];
+            items.clear();
+            while ( (size_type)items.size() < max ) {
+                size_type todo = max - (size_type)items.size();
+                size_type n = bufs.dequeue( chunk, todo < BatchSize ? todo : BatchSize );
+                for ( size_type i = 0; i != n; ++i ) {
+                    items.push_back( *chunk[i] );
+                    if (mpool.deallocate( chunk[i] ) == false)
+                        assert(false);
+                }
+                if ( n == 0 )
+                    break;
+            }
+            return items.size();
+        }
+
         value_t* PopWithoutRelease()
 	{
             Item* ipop;
@@ -46,6 +46,7 @@
 #include "../os/MutexLock.hpp"
 #include "BufferInterface.hpp"
 #include <deque>
+#include <algorithm>
 
 namespace RTT
 { namespace base {
@@ -159,6 +160,18 @@ namespace RTT
             return quant;
         }
 
+        size_type Pop(std::vector<T>& items, size_type max )
+        {
+            os::MutexLock locker(lock);
+            items.clear();
+            size_type quant = std::min( max, (size_type)buf.size() );
+            if ( quant <= 0 )
+                return 0;
+            items.assign( buf.begin(), buf.begin() + quant );
+            buf.erase( buf.begin(), buf.begin() + quant );
+            return quant;
+        }
+
 	value_t* PopWithoutRelease()
 	{
             os::MutexLock locker(lock);
@@ -0,0 +1,298 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  BufferSPSC.hpp
+
+                              BufferSPSC.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_BUFFER_SPSC_HPP
+#define ORO_BUFFER_SPSC_HPP
+
+#include "../os/oro_arch.h"
+#include "../os/Atomic.hpp"
+#include "BufferInterface.hpp"
+#include <vector>
+#include <cassert>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * A wait-free buffer implementation to read and write
+     * data of type \a T in a FIFO way, for exactly one writer
+     * thread and one reader thread.
+     *
+     * The samples are stored in place in a ring, so no memory pool
+     * is needed and neither side ever loops on a compare-and-swap.
+     * The writer only modifies the write index and the reader only the
+     * read index, which are kept on different cache lines.
+     *
+     * The reader may hold at most two samples returned by PopWithoutRelease()
+     * at a time. The writer never overwrites them until they are released.
+     * This buffer can not be circular, since dropping the oldest sample
+     * would be a read done by the writer.
+     * @param T The value type to be stored in the Buffer.
+     * @ingroup PortBuffers
+     */
+    template< class T>
+    class BufferSPSC
+        : public BufferInterface<T>
+    {
+    public:
+        typedef typename BufferInterface<T>::reference_t reference_t;
+        typedef typename BufferInterface<T>::param_t param_t;
+        typedef typename BufferInterface<T>::size_type size_type;
+        typedef T value_t;
+    private:
+        enum { CacheLineSize = 64, MaxHeld = 2 };
+
+        // capacity, plus the held samples, plus one slot
+        // to distinguish a full ring from an empty one.
+        const int mcap;
+        const int msize;
+        T* mbuf;
+        char mpad0[CacheLineSize];
+
+        /**
+         * The next slot to write. Only modified by the writer.
+         */
+        os::AtomicInt mwrite;
+        char mpad1[CacheLineSize];
+
+        /**
+         * The next slot to read. Only modified by the reader.
+         */
+        os::AtomicInt mread;
+        /**
+         * The oldest slot the writer may not overwrite: the oldest
+         * held sample or else the next slot to read.
+         * Only modified by the reader.
+         */
+        os::AtomicInt mfree;
+        int mheld[MaxHeld];
+        int mnheld;
+        char mpad2[CacheLineSize];
+
+        int next(int i) const
+        {
+            return i + 1 == msize ? 0 : i + 1;
+        }
+
+        /**
+         * Moves \a index to \a value. The barrier makes sure that
+         * all reads or writes of the slots are done before the other
+         * side sees the new index.
+         */
+        static void publish(os::AtomicInt& index, int value)
+        {
+            oro_mb();
+            index.set( value );
+        }
+
+        /**
+         * Returns the slot up to which the writer published samples.
+         * The barrier makes sure that the samples are only read
+         * after the index. Only called by the reader.
+         */
+        int written()
+        {
+            int w = mwrite.read();
+            oro_mb();
+            return w;
+        }
+
+        /**
+         * Tells the writer up to where it may write.
+         * Only called by the reader.
+         */
+        void update_free()
+        {
+            publish( mfree, mnheld ? mheld[0] : mread.read() );
+        }
+
+        int count() const
+        {
+            int c = const_cast<os::AtomicInt&>(mwrite).read() - const_cast<os::AtomicInt&>(mread).read();
+            return c >= 0 ? c : c + msize;
+        }
+
+        /**
+         * Returns the slot the writer may write to, or -1 if it can not.
+         */
+        int writable()
+        {
+            int w = mwrite.read();
+            if ( count() >= mcap || next(w) == mfree.read() )
+                return -1;
+            return w;
+        }
+
+        BufferSPSC(const BufferSPSC&);
+    public:
+        /**
+         * Create a wait-free buffer which can store \a bufsize elements.
+         * @param bufsize the capacity of the buffer.
+         * @param initial_value A sample used to initialize all slots.
+         */
+        BufferSPSC( unsigned int bufsize, const T& initial_value = T())
+            : mcap(bufsize), msize(bufsize + MaxHeld + 1), mbuf( new T[bufsize + MaxHeld + 1] ),
+              mwrite(0), mread(0), mfree(0), mnheld(0)
+        {
+            data_sample( initial_value );
+        }
+
+        ~BufferSPSC() {
+            delete[] mbuf;
+        }
+
+        virtual void data_sample( const T& sample )
+        {
+            for (int i = 0; i != msize; ++i)
+                mbuf[i] = sample;
+        }
+
+        virtual T data_sample() const
+        {
+            return mbuf[ const_cast<os::AtomicInt&>(mwrite).read() ];
+        }
+
+        size_type capacity() const
+        {
+            return mcap;
+        }
+
+        size_type size() const
+        {
+            return count();
+        }
+
+        bool empty() const
+        {
+            return count() == 0;
+        }
+
+        bool full() const
+        {
+            return count() == mcap;
+        }
+
+        void clear()
+        {
+            mread.set( mwrite.read() );
+            update_free();
+        }
+
+        bool Push( param_t item)
+        {
+            int w = writable();
+            if ( w == -1 )
+                return false;
+            mbuf[w] = item;
+            publish( mwrite, next(w) );
+            return true;
+        }
+
+        size_type Push(const std::vector<T>& items)
+        {
+            // fill the slots first and publish them all at once.
+            int w = mwrite.read();
+            typename std::vector<T>::const_iterator it = items.begin();
+            int c = count();
+            int f = mfree.read();
+            while ( it != items.end() && c != mcap && next(w) != f ) {
+                mbuf[w] = *it;
+                w = next(w);
+                ++c;
+                ++it;
+            }
+            publish( mwrite, w );
+            return it - items.begin();
+        }
+
+        bool Pop( reference_t item )
+        {
+            int r = mread.read();
+            if ( r == written() )
+                return false;
+            item = mbuf[r];
+            mread.set( next(r) );
+            update_free();
+            return true;
+        }
+
+        size_type Pop(std::vector<T>& items )
+        {
+            return Pop( items, mcap );
+        }
+
+        size_type Pop(std::vector<T>& items, size_type max )
+        {
+            int r = mread.read();
+            int w = written();
+            items.clear();
+            while ( r != w && (size_type)items.size() < max ) {
+                items.push_back( mbuf[r] );
+                r = next(r);
+            }
+            mread.set( r );
+            update_free();
+            return items.size();
+        }
+
+        value_t* PopWithoutRelease()
+        {
+            int r = mread.read();
+            if ( r == written() )
+                return 0;
+            assert( mnheld < MaxHeld && "BufferSPSC: too many samples held by the reader.");
+            mheld[mnheld++] = r;
+            // mfree already points to the oldest held sample.
+            mread.set( next(r) );
+            return &mbuf[r];
+        }
+
+        void Release(value_t *item)
+        {
+            int i = item - mbuf;
+            assert( mnheld > 0 );
+            if ( mheld[0] == i )
+                mheld[0] = mheld[1];
+            --mnheld;
+            update_free();
+        }
+    };
+}}
+
+#endif
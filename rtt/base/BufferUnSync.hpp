@@ -42,6 +42,7 @@
 
 #include "BufferInterface.hpp"
 #include <deque>
+#include <algorithm>
 
 namespace RTT
 { namespace base {
@@ -144,6 +145,17 @@ namespace RTT
             return quant;
         }
 
+        size_type Pop(std::vector<T>& items, size_type max )
+        {
+            items.clear();
+            size_type quant = std::min( max, (size_type)buf.size() );
+            if ( quant <= 0 )
+                return 0;
+            items.assign( buf.begin(), buf.begin() + quant );
+            buf.erase( buf.begin(), buf.begin() + quant );
+            return quant;
+        }
+
 	value_t* PopWithoutRelease()
 	{
 	    if(buf.empty())
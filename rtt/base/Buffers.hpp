@@ -51,6 +51,7 @@
 #include "Buffer.hpp"
 #include "BufferLocked.hpp"
 #include "BufferLockFree.hpp"
+#include "BufferSPSC.hpp"
 #include "DataObject.hpp"
 #include "DataObjectLockFree.hpp"
 #include "DataObjectLocked.hpp"
@@ -41,6 +41,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/call_traits.hpp>
+#include <vector>
 #include "ChannelElementBase.hpp"
 #include "../FlowStatus.hpp"
 
@@ -121,6 +122,37 @@ namespace RTT { namespace base {
             else
                 return NoData;
         }
+
+        /** Writes a batch of samples on this connection, oldest first.
+         * The default implementation calls write() for each sample.
+         * Elements which store data override this in order to store
+         * the whole batch at once.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeBatch(const std::vector<value_t>& samples)
+        {
+            for (typename std::vector<value_t>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+                if ( !this->write(*it) )
+                    return false;
+            return true;
+        }
+
+        /** Reads at most \a max new samples from the connection, oldest first.
+         * \a samples is cleared and then filled with the samples read.
+         * The default implementation calls read() as long as it returns NewData.
+         *
+         * @return the number of samples stored in \a samples.
+         */
+        virtual int readBatch(std::vector<value_t>& samples, int max)
+        {
+            samples.clear();
+            // a data sample has the right size for dynamically sized types.
+            value_t sample = this->data_sample();
+            while ( (int)samples.size() < max && this->read(sample, false) == NewData )
+                samples.push_back( sample );
+            return samples.size();
+        }
     };
 }}
 
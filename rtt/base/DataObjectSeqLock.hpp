@@ -0,0 +1,144 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  DataObjectSeqLock.hpp
+
+                         DataObjectSeqLock.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef CORELIB_DATAOBJECT_SEQLOCK_HPP
+#define CORELIB_DATAOBJECT_SEQLOCK_HPP
+
+
+#include "../os/oro_arch.h"
+#include "../os/Atomic.hpp"
+#include "DataObjectInterface.hpp"
+#include <boost/type_traits/is_pod.hpp>
+#include <cstring>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * @brief This DataObject is a lock-free implementation for one writer
+     * and any number of readers, based on a sequence counter.
+     *
+     * It keeps two copies of the data. The writer updates them one after
+     * the other and increments the sequence counter before each update,
+     * such that a reader always reads the copy that is not being written.
+     * A reader retries only if the writer started to update its copy while
+     * it was reading, so readers never wait for a preempted writer and do
+     * not write to shared memory at all. This makes reads of the latest
+     * value scale with the number of readers, unlike DataObjectLockFree,
+     * which must know the number of readers in advance.
+     *
+     * Since a reader may copy the data while it is being written,
+     * \a T must be a plain old data type. Such data is copied with
+     * std::memcpy, which compilers vectorize. ConnFactory
+     * only selects this implementation for such types.
+     *
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectSeqLock
+        : public DataObjectInterface<T>
+    {
+        /**
+         * Odd while data[0] is written, even while data[1] is.
+         * Readers read data[seq & 1].
+         */
+        mutable os::AtomicInt seq;
+        T data[2];
+
+        static void copy(T& to, const T& from, boost::true_type) { std::memcpy(&to, &from, sizeof(T)); }
+        static void copy(T& to, const T& from, boost::false_type) { to = from; }
+        static void copy(T& to, const T& from) { copy(to, from, boost::is_pod<T>()); }
+    public:
+        /**
+         * Construct a DataObjectSeqLock.
+         *
+         * @param initial_value The initial value of this DataObject.
+         */
+        DataObjectSeqLock( const T& initial_value = T() )
+            : seq(0)
+        {
+            data[0] = initial_value;
+            data[1] = initial_value;
+        }
+
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+
+        virtual void Get( DataType& pull ) const
+        {
+            int s;
+            do {
+                s = seq.read();
+                oro_mb();
+                copy( pull, data[s & 1] );
+                oro_mb();
+            } while ( seq.read() != s );
+        }
+
+        virtual DataType Get() const { DataType cache;  Get(cache); return cache; }
+
+        /**
+         * Set the data to a new value. Only one thread may call Set() at a time.
+         */
+        virtual void Set( const DataType& push )
+        {
+            seq.inc();
+            oro_mb();
+            copy( data[0], push );
+            oro_mb();
+            seq.inc();
+            oro_mb();
+            copy( data[1], push );
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            Set(sample);
+        }
+
+        virtual T data_sample() const
+        {
+            return Get();
+        }
+
+    };
+}}
+
+#endif
@@ -59,6 +59,19 @@ namespace RTT
         {
         protected:
             ExecutionEngine* engine;
+        private:
+            friend class RTT::ExecutionEngine;
+            /**
+             * The hooks of the run list of the engine we're
+             * loaded in. Only used by the thread of that engine.
+             */
+            ExecutableInterface* run_prev;
+            ExecutableInterface* run_next;
+            /**
+             * The lane in which we are linked in the run list,
+             * -1 if we are not linked.
+             */
+            int run_lane;
         public:
             /**
              * Called by the ExecutionEngine \a ee to tell
@@ -77,7 +90,21 @@ namespace RTT
              */
             void unloaded() { this->unloading(); engine = 0;}
 
-            ExecutableInterface() : engine(0) {}
+            ExecutableInterface() : engine(0), run_prev(0), run_next(0), run_lane(-1) {}
+
+            /**
+             * The copy keeps the engine pointer of \a orig, but is
+             * not linked in the run list of that engine.
+             */
+            ExecutableInterface(const ExecutableInterface& orig)
+                : engine(orig.engine), run_prev(0), run_next(0), run_lane(-1) {}
+
+            ExecutableInterface& operator=(const ExecutableInterface& orig)
+            {
+                engine = orig.engine;
+                return *this;
+            }
+
             virtual ~ExecutableInterface() {}
 
             /**
@@ -289,6 +289,56 @@ namespace RTT {
         return this->engine()->getActivity() ? this->engine()->getActivity()->setCpuAffinity(cpu) : false;
     }
 
+    bool TaskCore::setLaneCapacity(int lane, unsigned int capacity)
+    {
+        return this->engine()->setLaneCapacity( ExecutionEngine::Lane(lane), capacity );
+    }
+
+    bool TaskCore::setLaneOverflowPolicy(int lane, int policy)
+    {
+        if ( lane < 0 || lane >= ExecutionEngine::LaneCount
+             || policy < ExecutionEngine::DropOnOverflow || policy > ExecutionEngine::SpillOnOverflow )
+            return false;
+        this->engine()->setLaneOverflowPolicy( ExecutionEngine::Lane(lane), ExecutionEngine::OverflowPolicy(policy) );
+        return true;
+    }
+
+    unsigned int TaskCore::getLaneHighWater(int lane) const
+    {
+        return this->engine()->getLaneStatistics( ExecutionEngine::Lane(lane) ).high_water;
+    }
+
+    unsigned int TaskCore::getLaneDrops(int lane) const
+    {
+        return this->engine()->getLaneStatistics( ExecutionEngine::Lane(lane) ).drops;
+    }
+
+    void TaskCore::setCycleProfiling(bool on)
+    {
+        this->engine()->setProfiling( on );
+    }
+
+    void TaskCore::resetCycleProfile()
+    {
+        this->engine()->resetProfile();
+    }
+
+    std::vector<double> TaskCore::getCycleProfile(int phase) const
+    {
+        std::vector<double> result;
+        if ( phase < 0 || phase >= ExecutionEngine::ProfilePhaseCount )
+            return result;
+        ExecutionEngine::PhaseStatistics ps = this->engine()->getPhaseStatistics( ExecutionEngine::ProfilePhase(phase) );
+        result.reserve( 4 + ExecutionEngine::PROFILE_BUCKETS );
+        result.push_back( ps.count );
+        result.push_back( nsecs_to_Seconds(ps.min) );
+        result.push_back( nsecs_to_Seconds(ps.max) );
+        result.push_back( ps.count ? nsecs_to_Seconds(ps.total) / ps.count : 0.0 );
+        for (unsigned int i = 0; i != ExecutionEngine::PROFILE_BUCKETS; ++i)
+            result.push_back( ps.histogram[i] );
+        return result;
+    }
+
     bool TaskCore::configureHook() {
         return true;
     }
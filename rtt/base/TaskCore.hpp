@@ -40,6 +40,7 @@
 #define ORO_TASK_CORE_HPP
 
 #include <string>
+#include <vector>
 #include "../rtt-fwd.hpp"
 #include "../rtt-config.h"
 #include "../Time.hpp"
@@ -256,6 +257,61 @@ namespace RTT
          */
         virtual bool setCpuAffinity(unsigned cpu);
 
+        /**
+         * Sets the number of messages and functions that can be queued
+         * in a lane of this component's engine. You may call this at
+         * any time from a non real-time thread.
+         * @param lane The lane number, see ExecutionEngine::Lane.
+         * @see ExecutionEngine::setLaneCapacity()
+         */
+        virtual bool setLaneCapacity(int lane, unsigned int capacity);
+
+        /**
+         * Sets what happens with messages sent to this component
+         * when a lane of its engine is full.
+         * @param lane The lane number, see ExecutionEngine::Lane.
+         * @param policy The policy number, see ExecutionEngine::OverflowPolicy.
+         * @see ExecutionEngine::setLaneOverflowPolicy()
+         */
+        virtual bool setLaneOverflowPolicy(int lane, int policy);
+
+        /**
+         * Returns the largest number of messages found in a lane
+         * of this component's engine.
+         * @see ExecutionEngine::getLaneStatistics()
+         */
+        unsigned int getLaneHighWater(int lane) const;
+
+        /**
+         * Returns the number of messages and functions rejected
+         * because a lane of this component's engine was full.
+         * @see ExecutionEngine::getLaneStatistics()
+         */
+        unsigned int getLaneDrops(int lane) const;
+
+        /**
+         * Enables or disables timing the phases of each step of
+         * this component's engine.
+         * @see ExecutionEngine::setProfiling()
+         */
+        virtual void setCycleProfiling(bool on);
+
+        /**
+         * Clears the timing statistics of this component's engine.
+         * @see ExecutionEngine::resetProfile()
+         */
+        virtual void resetCycleProfile();
+
+        /**
+         * Returns the timing statistics of a phase of the steps of this
+         * component's engine as: the number of samples, the minimum, maximum
+         * and mean in seconds, followed by the ExecutionEngine::PROFILE_BUCKETS
+         * histogram counts.
+         * @param phase The phase number, see ExecutionEngine::ProfilePhase.
+         * @return an empty vector if \a phase is invalid.
+         */
+        std::vector<double> getCycleProfile(int phase) const;
+
         /**
          * Inspect if the component is in the FatalError state.
          * There is no possibility to recover from this state.
@@ -58,6 +58,15 @@
 #include <errno.h>
 #endif
 
+#if defined(OROPKG_OS_GNULINUX)
+// Xenomai RTDM devices can not be added to an epoll set, so only the gnulinux
+// target uses it.
+#define ORO_FDACTIVITY_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
+
 #include <boost/cstdint.hpp>
 
 using namespace RTT;
@@ -79,6 +88,8 @@ const char FileDescriptorActivity::CMD_UPDATE_SETS;
 FileDescriptorActivity::FileDescriptorActivity(int priority, RunnableInterface* _r, const std::string& name )
     : Activity(priority, 0.0, _r, name)
     , m_running(false)
+    , m_epoll_fd(-1), m_event_fd(-1), m_timer_fd(-1)
+    , m_break_request(false), m_trigger_request(false)
     , m_timeout(0)
 {
     FD_ZERO(&m_fd_set);
@@ -97,6 +108,8 @@ FileDescriptorActivity::FileDescriptorActivity(int priority, RunnableInterface*
 FileDescriptorActivity::FileDescriptorActivity(int scheduler, int priority, RunnableInterface* _r, const std::string& name )
     : Activity(scheduler, priority, 0.0, _r, name)
     , m_running(false)
+    , m_epoll_fd(-1), m_event_fd(-1), m_timer_fd(-1)
+    , m_break_request(false), m_trigger_request(false)
     , m_timeout(0)
 {
     FD_ZERO(&m_fd_set);
@@ -111,8 +124,12 @@ FileDescriptorActivity::~FileDescriptorActivity()
 bool FileDescriptorActivity::isRunning() const
 { return Activity::isRunning() && m_running; }
 int FileDescriptorActivity::getTimeout() const
-{ return m_timeout; }
+{ return int(m_timeout / NSECS_IN_MSECS); }
 void FileDescriptorActivity::setTimeout(int timeout)
+{ m_timeout = msecs_to_nsecs(timeout); }
+nsecs FileDescriptorActivity::getTimeoutNSecs() const
+{ return m_timeout; }
+void FileDescriptorActivity::setTimeoutNSecs(nsecs timeout)
 { m_timeout = timeout; }
 void FileDescriptorActivity::watch(int fd)
 { RTT::os::MutexLock lock(m_lock);
@@ -122,21 +139,56 @@ void FileDescriptorActivity::watch(int fd)
         return;
     }
 
+#ifdef ORO_FDACTIVITY_EPOLL
+    if (!m_watched_fds.insert(fd).second)
+        return;
+    if (m_epoll_fd != -1)
+    {
+        epoll_event ev;
+        ev.events  = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1)
+        {
+            log(Error) << "FileDescriptorActivity: cannot watch file descriptor " << fd << ", errno = " << errno << endlog();
+            m_watched_fds.erase(fd);
+        }
+    }
+#else
     m_watched_fds.insert(fd);
     FD_SET(fd, &m_fd_set);
     triggerUpdateSets();
+#endif
 }
 void FileDescriptorActivity::unwatch(int fd)
 { RTT::os::MutexLock lock(m_lock);
+#ifdef ORO_FDACTIVITY_EPOLL
+    if (m_watched_fds.erase(fd) && m_epoll_fd != -1)
+    {
+        // The FD may already be closed, which removed it from the set.
+        epoll_event ev;
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, &ev);
+    }
+#else
     m_watched_fds.erase(fd);
     FD_CLR(fd, &m_fd_set);
     triggerUpdateSets();
+#endif
 }
 void FileDescriptorActivity::clearAllWatches()
 { RTT::os::MutexLock lock(m_lock);
+#ifdef ORO_FDACTIVITY_EPOLL
+    if (m_epoll_fd != -1)
+    {
+        epoll_event ev;
+        for (std::set<int>::const_iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); ++it)
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, *it, &ev);
+    }
+    m_watched_fds.clear();
+#else
     m_watched_fds.clear();
     FD_ZERO(&m_fd_set);
     triggerUpdateSets();
+#endif
 }
 void FileDescriptorActivity::triggerUpdateSets()
 {
@@ -145,15 +197,231 @@ void FileDescriptorActivity::triggerUpdateSets()
     i = i;
 }
 bool FileDescriptorActivity::isUpdated(int fd) const
-{ return FD_ISSET(fd, &m_fd_work); }
+{
+#ifdef ORO_FDACTIVITY_EPOLL
+    return std::binary_search(m_updated_fds.begin(), m_updated_fds.end(), fd);
+#else
+    return FD_ISSET(fd, &m_fd_work);
+#endif
+}
+const std::vector<int>& FileDescriptorActivity::getUpdatedFds() const
+{ return m_updated_fds; }
 bool FileDescriptorActivity::hasError() const
 { return m_has_error; }
 bool FileDescriptorActivity::hasTimeout() const
 { return m_has_timeout; }
 bool FileDescriptorActivity::isWatched(int fd) const
 { RTT::os::MutexLock lock(m_lock);
-    return FD_ISSET(fd, &m_fd_set); }
+    return m_watched_fds.count(fd) != 0; }
+
+struct fd_watch {
+    int& fd;
+    fd_watch(int& fd) : fd(fd) {}
+    ~fd_watch()
+    {
+        close(fd);
+        fd = -1;
+    };
+};
+
+#ifdef ORO_FDACTIVITY_EPOLL
+/** Same as fd_watch, for FDs which are used by watch() and unwatch() */
+struct locked_fd_watch {
+    RTT::os::Mutex& lock;
+    int& fd;
+    locked_fd_watch(RTT::os::Mutex& lock, int& fd) : lock(lock), fd(fd) {}
+    ~locked_fd_watch()
+    {
+        RTT::os::MutexLock guard(lock);
+        close(fd);
+        fd = -1;
+    };
+};
+
+namespace {
+    void close_fd(int& fd)
+    {
+        if (fd != -1)
+            close(fd);
+        fd = -1;
+    }
+}
 
+bool FileDescriptorActivity::start()
+{
+    if (isActive())
+        return false;
+
+    { RTT::os::MutexLock lock(m_lock);
+        m_epoll_fd = epoll_create(1);
+        m_event_fd = eventfd(0, EFD_NONBLOCK);
+        if (m_epoll_fd == -1 || m_event_fd == -1)
+        {
+            log(Error) << "FileDescriptorActivity: cannot create epoll set, errno = " << errno << endlog();
+            close_fd(m_epoll_fd);
+            close_fd(m_event_fd);
+            return false;
+        }
+
+        epoll_event ev;
+        ev.events  = EPOLLIN;
+        ev.data.fd = m_event_fd;
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_event_fd, &ev);
+        for (std::set<int>::iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); )
+        {
+            ev.data.fd = *it;
+            if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, *it, &ev) == -1)
+            {
+                log(Error) << "FileDescriptorActivity: cannot watch file descriptor " << *it << ", errno = " << errno << endlog();
+                m_watched_fds.erase(it++);
+            }
+            else
+                ++it;
+        }
+        m_break_request = m_trigger_request = false;
+    }
+
+    if (!Activity::start())
+    {
+        RTT::os::MutexLock lock(m_lock);
+        close_fd(m_epoll_fd);
+        close_fd(m_event_fd);
+        return false;
+    }
+    return true;
+}
+
+bool FileDescriptorActivity::wakeup(char cmd)
+{
+    if (cmd == CMD_BREAK_LOOP)
+        m_break_request = true;
+    else
+        m_trigger_request = true;
+    // The eventfd counter coalesces the requests, loop() reads the flags
+    // after resetting it.
+    boost::uint64_t one = 1;
+    return write(m_event_fd, &one, sizeof(one)) == sizeof(one);
+}
+
+bool FileDescriptorActivity::trigger()
+{ return wakeup(CMD_TRIGGER); }
+
+void FileDescriptorActivity::loop()
+{
+    static const int MaxEvents = 64;
+    epoll_event events[MaxEvents];
+    locked_fd_watch watch_epoll(m_lock, m_epoll_fd);
+    fd_watch watch_event(m_event_fd);
+    fd_watch watch_timer(m_timer_fd);
+
+    // Timeouts of whole milliseconds are given to epoll_wait(), the others
+    // are armed on a timerfd which is part of the epoll set.
+    nsecs timeout = m_timeout;
+    bool use_timerfd = (timeout % NSECS_IN_MSECS) != 0;
+    if (use_timerfd)
+    {
+        m_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+        epoll_event ev;
+        ev.events  = EPOLLIN;
+        ev.data.fd = m_timer_fd;
+        if (m_timer_fd == -1 || epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_timer_fd, &ev) == -1)
+        {
+            log(Error) << "FileDescriptorActivity: cannot create timerfd, rounding the timeout to milliseconds" << endlog();
+            close_fd(m_timer_fd);
+            use_timerfd = false;
+            timeout = std::max(nsecs(NSECS_IN_MSECS), timeout - timeout % NSECS_IN_MSECS);
+        }
+    }
+
+    while(true)
+    {
+        int wait_ms = -1;
+        if (use_timerfd)
+        {
+            itimerspec spec = { { 0, 0 }, { timeout / NSECS_IN_SECS, timeout % NSECS_IN_SECS } };
+            timerfd_settime(m_timer_fd, 0, &spec, NULL);
+        }
+        else if (timeout != 0)
+            wait_ms = int(timeout / NSECS_IN_MSECS);
+
+        m_running = false;
+        int ret = epoll_wait(m_epoll_fd, events, MaxEvents, wait_ms);
+
+        m_has_error   = false;
+        m_has_timeout = false;
+        m_updated_fds.clear();
+        bool woken = false, timer_expired = false;
+        if (ret == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            log(Error) << "FileDescriptorActivity: error in epoll_wait(), errno = " << errno << endlog();
+            m_has_error = true;
+        }
+        for (int i = 0; i < ret; ++i)
+        {
+            int fd = events[i].data.fd;
+            if (fd == m_event_fd)
+                woken = true;
+            else if (fd == m_timer_fd)
+                timer_expired = true;
+            else
+                m_updated_fds.push_back(fd);
+        }
+        std::sort(m_updated_fds.begin(), m_updated_fds.end());
+
+        bool do_trigger = true;
+        if (woken) // breakLoop or trigger requests
+        {
+            boost::uint64_t count;
+            int i = read(m_event_fd, &count, sizeof(count));
+            i = i;
+
+            if (m_break_request)
+                break;
+            do_trigger = m_trigger_request;
+            m_trigger_request = false;
+        }
+
+        // Re-arming the timerfd above resets its expiration count, so it
+        // never needs to be read.
+        if (ret == 0 || (timer_expired && !woken && m_updated_fds.empty()))
+        {
+            log(Error) << "FileDescriptorActivity: timeout in epoll_wait()" << endlog();
+            m_has_timeout = true;
+            do_trigger = true;
+        }
+
+        if (do_trigger)
+        {
+            try
+            {
+                m_running = true;
+                step();
+                m_running = false;
+            }
+            catch(...)
+            {
+                m_running = false;
+                throw;
+            }
+        }
+    }
+    m_updated_fds.clear();
+}
+
+bool FileDescriptorActivity::breakLoop()
+{
+    if (!wakeup(CMD_BREAK_LOOP))
+        return false;
+
+    // either OS::SingleThread properly waits for loop() to return, or we are
+    // called from within loop() [for instance because updateHook() called
+    // fatal()]. In both cases, just return.
+    return true;
+}
+
+#else
 bool FileDescriptorActivity::start()
 {
     if (pipe(m_interrupt_pipe) == -1)
@@ -172,18 +440,11 @@ bool FileDescriptorActivity::start()
     return true;
 }
 
-bool FileDescriptorActivity::trigger()
-{ return write(m_interrupt_pipe[1], &CMD_TRIGGER, 1) == 1; }
+bool FileDescriptorActivity::wakeup(char cmd)
+{ return write(m_interrupt_pipe[1], &cmd, 1) == 1; }
 
-struct fd_watch {
-    int& fd;
-    fd_watch(int& fd) : fd(fd) {}
-    ~fd_watch()
-    {
-        close(fd);
-        fd = -1;
-    };
-};
+bool FileDescriptorActivity::trigger()
+{ return wakeup(CMD_TRIGGER); }
 
 void FileDescriptorActivity::loop()
 {
@@ -212,12 +473,19 @@ void FileDescriptorActivity::loop()
         }
         else
         {
-            timeval timeout = { m_timeout / 1000, (m_timeout % 1000) * 1000 };
+            timeval timeout = { m_timeout / NSECS_IN_SECS, (m_timeout % NSECS_IN_SECS) / NSECS_IN_USECS };
             ret = select(max_fd + 1, &m_fd_work, NULL, NULL, &timeout);
         }
 
         m_has_error   = false;
         m_has_timeout = false;
+        m_updated_fds.clear();
+        if (ret > 0)
+        { RTT::os::MutexLock lock(m_lock);
+            for (std::set<int>::const_iterator it = m_watched_fds.begin(); it != m_watched_fds.end(); ++it)
+                if (FD_ISSET(*it, &m_fd_work))
+                    m_updated_fds.push_back(*it);
+        }
         if (ret == -1)
         {
             log(Error) << "FileDescriptorActivity: error in select(), errno = " << errno << endlog();
@@ -284,7 +552,7 @@ void FileDescriptorActivity::loop()
 
 bool FileDescriptorActivity::breakLoop()
 {
-    if (write(m_interrupt_pipe[1], &CMD_BREAK_LOOP, 1) != 1)
+    if (!wakeup(CMD_BREAK_LOOP))
         return false;
 
     // either OS::SingleThread properly waits for loop() to return, or we are
@@ -292,6 +560,7 @@ bool FileDescriptorActivity::breakLoop()
     // fatal()]. In both cases, just return.
     return true;
 }
+#endif
 
 void FileDescriptorActivity::step()
 {
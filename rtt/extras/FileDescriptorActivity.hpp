@@ -40,7 +40,9 @@
 #define FILEDESCRIPTOR_ACTIVITY_HPP
 
 #include "../Activity.hpp"
+#include "../os/Time.hpp"
 #include <set>
+#include <vector>
 
 namespace RTT { namespace extras {
 
@@ -97,17 +99,37 @@ namespace RTT { namespace extras {
      *   }
      * }
      * </code>
+     *
+     * When many FDs are watched, getUpdatedFds() returns only the ones that
+     * are ready, which avoids testing each watched FD with isUpdated().
+     *
+     * On GNU/Linux, the activity is implemented with epoll(7): the watched
+     * FDs are not limited to FD_SETSIZE, watch() and unwatch() do not need to
+     * wake up the activity, and trigger() and breakLoop() go through an
+     * eventfd. Timeouts which are not a whole number of milliseconds are
+     * handled by a timerfd. Other targets use select(2) on a control pipe.
+     * epoll(7) refuses regular files and directories, which are always
+     * readable anyway: watching them logs an error and leaves them unwatched.
      */
     class RTT_API FileDescriptorActivity : public Activity
     {
         std::set<int> m_watched_fds;
         bool m_running;
         int  m_interrupt_pipe[2];
-        int  m_timeout;
+        /** The epoll set, its wakeup eventfd and the timerfd (epoll only) */
+        int  m_epoll_fd;
+        int  m_event_fd;
+        int  m_timer_fd;
+        /** Pending breakLoop() and trigger() requests (epoll only) */
+        volatile bool m_break_request;
+        volatile bool m_trigger_request;
+        nsecs m_timeout;
         /** Lock that protects the access to m_fd_set and m_watched_fds */
         mutable RTT::os::Mutex m_lock;
         fd_set m_fd_set;
         fd_set m_fd_work;
+        /** Sorted list of the FDs that made the last wait return */
+        std::vector<int> m_updated_fds;
         bool m_has_error;
         bool m_has_timeout;
 
@@ -120,6 +142,11 @@ namespace RTT { namespace extras {
          */
         void triggerUpdateSets();
 
+        /** Internal method that wakes up loop() after a breakLoop() or
+         * trigger() request has been recorded
+         */
+        bool wakeup(char cmd);
+
     public:
         /**
          * Create a FileDescriptorActivity with a given priority and base::RunnableInterface
@@ -181,6 +208,14 @@ namespace RTT { namespace extras {
          */
         bool isUpdated(int fd) const;
 
+        /** The sorted list of FDs which have new data.
+         *
+         * This should only be used from within the base::RunnableInterface this
+         * activity is driving, i.e. in TaskContext::updateHook() or
+         * TaskContext::errorHook().
+         */
+        const std::vector<int>& getUpdatedFds() const;
+
         /** True if the base::RunnableInterface has been triggered because of a
          * timeout, instead of because of new data is available.
          *
@@ -209,6 +244,16 @@ namespace RTT { namespace extras {
          */
         int getTimeout() const;
 
+        /** Sets the timeout, in nanoseconds, for waiting on the IO. Set to 0
+         * for blocking behaviour (no timeout). On GNU/Linux, the full
+         * resolution is used, other targets round it to microseconds.
+         */
+        void setTimeoutNSecs(nsecs timeout);
+
+        /** Get the timeout, in nanoseconds, for waiting on the IO.
+         */
+        nsecs getTimeoutNSecs() const;
+
         virtual bool start();
         virtual void loop();
         virtual bool breakLoop();
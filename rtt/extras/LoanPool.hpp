@@ -0,0 +1,255 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  LoanPool.hpp
+
+                        LoanPool.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef RTT_LOAN_POOL_HPP
+#define RTT_LOAN_POOL_HPP
+
+#include "../os/Atomic.hpp"
+#include "../internal/MWSRQueue.hpp"
+
+namespace RTT
+{ namespace extras {
+
+        template<typename T>
+        struct LoanPoolStorage;
+
+        /**
+         * A sample of a LoanPool, with the number of LoanedPointer
+         * objects that refer to it.
+         */
+        template<typename T>
+        struct LoanSlot
+        {
+            T value;
+            os::AtomicInt refs;
+            LoanPoolStorage<T>* storage;
+        };
+
+        /**
+         * The samples of a LoanPool. It is deleted when the LoanPool
+         * is destroyed and the last loaned sample was returned.
+         */
+        template<typename T>
+        struct LoanPoolStorage
+        {
+            LoanSlot<T>* slots;
+            unsigned int size;
+            /** The samples which are not loaned. */
+            internal::MWSRQueue<LoanSlot<T>*> available;
+            /** One for the LoanPool and one for each loaned sample. */
+            os::AtomicInt refs;
+
+            LoanPoolStorage(unsigned int size, const T& sample)
+                : slots( new LoanSlot<T>[size] ), size(size), available(size), refs(1)
+            {
+                for (unsigned int i = 0; i != size; ++i) {
+                    slots[i].value = sample;
+                    slots[i].storage = this;
+                    available.enqueue( &slots[i] );
+                }
+            }
+
+            ~LoanPoolStorage() { delete[] slots; }
+
+            void deref()
+            {
+                if ( refs.dec_and_test() )
+                    delete this;
+            }
+
+            void release(LoanSlot<T>* slot)
+            {
+                available.enqueue( slot );
+                deref();
+            }
+        };
+
+    /** Smart pointer to a sample of a LoanPool.
+     *
+     * Copying a LoanedPointer only increments an atomic reference count,
+     * such that it can be written to and read from data ports without
+     * copying the sample itself: connect an OutputPort< LoanedPointer<T> >
+     * to InputPort< LoanedPointer<T> > objects. The sample returns to its
+     * pool when the last LoanedPointer to it is destroyed. This never
+     * allocates memory and never locks, unlike ReadOnlyPointer.
+     *
+     * The sample can only be modified through write_access(), as long as
+     * the pointer was not shared yet. Readers only get const access.
+     */
+    template<typename T>
+    class LoanedPointer
+    {
+        LoanSlot<T>* slot;
+
+        void release()
+        {
+            if ( slot && slot->refs.dec_and_test() )
+                slot->storage->release( slot );
+            slot = 0;
+        }
+    public:
+        /**
+         * Creates an invalid pointer.
+         */
+        LoanedPointer()
+            : slot(0) {}
+
+        /**
+         * Takes the first reference to \a s. Used by LoanPool.
+         */
+        explicit LoanedPointer(LoanSlot<T>* s)
+            : slot(s) {}
+
+        LoanedPointer(const LoanedPointer& orig)
+            : slot(orig.slot)
+        {
+            if ( slot )
+                slot->refs.inc();
+        }
+
+        LoanedPointer& operator=(const LoanedPointer& orig)
+        {
+            if ( orig.slot == slot )
+                return *this;
+            if ( orig.slot )
+                orig.slot->refs.inc();
+            release();
+            slot = orig.slot;
+            return *this;
+        }
+
+        ~LoanedPointer() { release(); }
+
+        T const& operator *() const { return slot->value; }
+        T const* operator ->() const { return &slot->value; }
+
+        /** True if this refers to a sample */
+        bool valid() const
+        { return slot != 0; }
+
+        T const* get() const
+        {
+            return slot ? &slot->value : 0;
+        }
+
+        /** True if this is the only pointer to its sample */
+        bool unique() const
+        {
+            return slot && slot->refs.read() == 1;
+        }
+
+        /** Gets write access to the sample, in order to fill it in
+         * before it is written to a port.
+         *
+         * @return null if the sample is shared with other pointers,
+         * since they may be reading it concurrently.
+         */
+        T* write_access()
+        {
+            return unique() ? &slot->value : 0;
+        }
+
+        /** Drops the reference to the sample, which returns to
+         * its pool if this was the last one. */
+        void reset()
+        {
+            release();
+        }
+    };
+
+    /** A fixed size pool of samples which are loaned out through
+     * LoanedPointer objects.
+     *
+     * All samples are copies of a given sample, which allows to reserve
+     * the memory of dynamically sized types up front. A returned sample
+     * keeps its contents and capacity, and is handed out again by a
+     * later loan().
+     *
+     * Size the pool for the samples held by the writer, the connections
+     * and the readers. A data connection holds up to a few samples, a
+     * buffered connection as many as its buffer size.
+     */
+    template<typename T>
+    class LoanPool
+    {
+        LoanPoolStorage<T>* storage;
+
+        LoanPool(const LoanPool&);
+        LoanPool& operator=(const LoanPool&);
+    public:
+        /**
+         * Creates a pool of \a size copies of \a sample.
+         */
+        LoanPool(unsigned int size, const T& sample = T())
+            : storage( new LoanPoolStorage<T>(size, sample) ) {}
+
+        /**
+         * The samples which are still loaned remain valid
+         * after the pool is destroyed.
+         */
+        ~LoanPool() { storage->deref(); }
+
+        /**
+         * Loans a sample from the pool. It may only be called from
+         * one thread at a time, typically the writer's thread.
+         * @return an invalid pointer if all samples are loaned.
+         */
+        LoanedPointer<T> loan()
+        {
+            LoanSlot<T>* slot = 0;
+            if ( !storage->available.dequeue( slot ) )
+                return LoanedPointer<T>();
+            slot->refs.set(1);
+            storage->refs.inc();
+            return LoanedPointer<T>( slot );
+        }
+
+        /**
+         * Returns the number of samples in this pool.
+         */
+        unsigned int capacity() const { return storage->size; }
+
+        /**
+         * Returns the number of samples that can be loaned.
+         * May only be called from the thread calling loan().
+         */
+        unsigned int available() const { return storage->available.size(); }
+    };
+}}
+
+#endif
@@ -98,6 +98,8 @@ namespace RTT {
     }
 
     void PeriodicActivity::init() {
+        tick_multiple = 1;
+        tick_phase = 0;
     }
 
     bool PeriodicActivity::start()
@@ -158,13 +160,32 @@ namespace RTT {
 
     Seconds PeriodicActivity::getPeriod() const
     {
-        return thread_->getPeriod();
+        return thread_->getPeriod() * tick_multiple;
     }
 
     bool PeriodicActivity::setPeriod(Seconds s) {
         return false;
     }
 
+    bool PeriodicActivity::setTickSchedule(unsigned int multiple, unsigned int phase)
+    {
+        if ( isActive() || multiple == 0 || phase >= multiple )
+            return false;
+        tick_multiple = multiple;
+        tick_phase = phase;
+        return true;
+    }
+
+    unsigned int PeriodicActivity::getTickMultiple() const
+    {
+        return tick_multiple;
+    }
+
+    unsigned int PeriodicActivity::getTickPhase() const
+    {
+        return tick_phase;
+    }
+
     unsigned PeriodicActivity::getCpuAffinity() const
     {
       return thread_->getCpuAffinity();
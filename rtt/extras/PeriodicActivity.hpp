@@ -186,6 +186,28 @@ namespace RTT
 
         virtual bool setPeriod(Seconds s);
 
+        /**
+         * Only run this activity every \a multiple ticks of its TimerThread,
+         * at the ticks where the TimerThread's tick count modulo \a multiple
+         * equals \a phase. Activities of the same thread with the same multiple
+         * and a different phase are spread over the ticks, which levels
+         * the CPU load. The default is to run every tick (multiple 1, phase 0).
+         * @param multiple The number of thread ticks between two steps, at least 1.
+         * @param phase The tick offset, smaller than \a multiple.
+         * @return false if the activity is active or the arguments are invalid.
+         */
+        bool setTickSchedule(unsigned int multiple, unsigned int phase);
+
+        /**
+         * The number of TimerThread ticks between two steps of this activity.
+         */
+        unsigned int getTickMultiple() const;
+
+        /**
+         * The tick offset of this activity within its multiple.
+         */
+        unsigned int getTickPhase() const;
+
         virtual unsigned getCpuAffinity() const;
 
         virtual bool setCpuAffinity(unsigned cpu);
@@ -220,6 +242,12 @@ namespace RTT
          */
         bool active;
 
+        /**
+         * Run every tick_multiple ticks of thread_, at offset tick_phase.
+         */
+        unsigned int tick_multiple;
+        unsigned int tick_phase;
+
         /**
          * The thread which runs this activity.
          */
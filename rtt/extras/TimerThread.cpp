@@ -88,13 +88,13 @@ namespace RTT {
     }
 
     TimerThread::TimerThread(int priority, const std::string& name, double periodicity, unsigned cpu_affinity)
-        : Thread( ORO_SCHED_RT, priority, periodicity, cpu_affinity, name), cleanup(false)
+        : Thread( ORO_SCHED_RT, priority, periodicity, cpu_affinity, name), ticks(0), cleanup(false)
     {
     	tasks.reserve(MAX_ACTIVITIES);
     }
 
     TimerThread::TimerThread(int scheduler, int priority, const std::string& name, double periodicity, unsigned cpu_affinity)
-        : Thread(scheduler, priority, periodicity, cpu_affinity, name), cleanup(false)
+        : Thread(scheduler, priority, periodicity, cpu_affinity, name), ticks(0), cleanup(false)
     {
     	tasks.reserve(MAX_ACTIVITIES);
     }
@@ -105,13 +105,24 @@ namespace RTT {
         this->stop();
     }
 
+    TimerThread::ActivityList& TimerThread::tickList( PeriodicActivity* t ) {
+        unsigned int multiple = t->getTickMultiple();
+        std::vector<TickSchedule>::iterator it = schedules.begin();
+        while ( it != schedules.end() && it->multiple != multiple )
+            ++it;
+        if ( it == schedules.end() ) {
+            TickSchedule ts;
+            ts.multiple = multiple;
+            ts.phases.resize( multiple );
+            it = schedules.insert( schedules.end(), ts );
+        }
+        return it->phases[ t->getTickPhase() ];
+    }
+
     bool TimerThread::addActivity( PeriodicActivity* t ) {
         MutexLock lock(mutex);
-        if ( tasks.size() == MAX_ACTIVITIES ) {
-//             Logger::log() << Logger:: << "TimerThread : tasks queue full, failed to add Activity : "<< t << Logger::endl;
-            return false;
-        }
         tasks.push_back( t );
+        tickList( t ).push_back( t );
 //         Logger::log() << Logger::Debug << "TimerThread : successfully started Activity : "<< t  << Logger::endl;
         return true;
     }
@@ -121,6 +132,10 @@ namespace RTT {
         ActivityList::iterator it = find(tasks.begin(), tasks.end(), t);
         if ( it != tasks.end() ) {
             *it = 0; // clear task away
+            ActivityList& tl = tickList( t );
+            ActivityList::iterator tit = find(tl.begin(), tl.end(), t);
+            if ( tit != tl.end() )
+                *tit = 0;
             cleanup = true;
             return true;
         }
@@ -145,45 +160,27 @@ namespace RTT {
     void TimerThread::step() {
         MutexLock lock(mutex);
 
-        // The size of the tasks vector does not change during add/remove, thus
-        // t_iter is never invalidated.
-        for( ActivityList::iterator t_iter = tasks.begin(); t_iter != tasks.end(); ++t_iter)
-        	if ( *t_iter )
-        		(*t_iter)->step();
+        // Only the activities of this tick's phase are visited. step() may
+        // add activities, so indexes are used, which survive a reallocation.
+        for( unsigned int s = 0; s != schedules.size(); ++s) {
+            unsigned int phase = unsigned( ticks % schedules[s].multiple );
+            for( unsigned int i = 0; i < schedules[s].phases[phase].size(); ++i)
+                if ( PeriodicActivity* t = schedules[s].phases[phase][i] )
+                    t->step();
+        }
+        ++ticks;
 
         if ( cleanup )
             this->reorderList();
     }
 
     void TimerThread::reorderList() {
-        // reorder the list to remove clear'ed tasks
-        ActivityList::iterator begin = tasks.begin();
-        // first zero :
+        // remove the clear'ed tasks, keeping the order of the others
         PeriodicActivity* nullActivity = 0;
-        ActivityList::iterator it = tasks.begin();
-
-        it = find( tasks.begin(), tasks.end(), nullActivity); // First zero
-        begin = it+1;
-        while ( it != tasks.end() ) {
-            // Look for first non-zero after 'it' :
-            while ( begin != tasks.end() &&  *begin == 0  )
-                ++begin;
-            if ( begin == tasks.end() )  { // if no task found after zero :
-//                 Logger::log() << Logger::Error << "beginBefore resize :"<< tasks.size() << Logger::endl;
-                tasks.resize( it - tasks.begin() ); // cut out the items after 'it'
-//                 Logger::log() << Logger::Error << "beginAfter resize :"<< tasks.size() << Logger::endl;
-                break; // This is our exit condition !
-            }
-            // first zero after begin :
-            ActivityList::iterator end = find ( begin, tasks.end(), nullActivity);
-            // if end == tasks.end() ==> next while will copy all
-            // if end != tasks.end() ==> next while will copy first zero's
-            while ( begin != end ) {
-                *it = *begin; // copy operation
-                ++begin;
-                ++it; // go to next slot to inspect.
-            }
-        }
+        tasks.erase( remove( tasks.begin(), tasks.end(), nullActivity ), tasks.end() );
+        for( std::vector<TickSchedule>::iterator s = schedules.begin(); s != schedules.end(); ++s)
+            for( std::vector<ActivityList>::iterator p = s->phases.begin(); p != s->phases.end(); ++p)
+                p->erase( remove( p->begin(), p->end(), nullActivity ), p->end() );
 
         cleanup = false;
     }
@@ -64,6 +64,12 @@ namespace RTT
      * This Periodic Thread is meant for executing a PeriodicActivity
      * object periodically.
      *
+     * The thread counts its ticks and runs each activity only on the ticks
+     * selected by PeriodicActivity::setTickSchedule(). The activities are
+     * bucketed by multiple and phase, such that a step only visits the
+     * activities which are due. The period is kept on an absolute timeline
+     * against the monotonic clock, such that the ticks do not drift.
+     *
      * @see PeriodicActivity
      */
     class RTT_API TimerThread
@@ -71,8 +77,22 @@ namespace RTT
     {
         typedef std::vector<PeriodicActivity*> ActivityList ;
         ActivityList tasks;
+        /**
+         * The activities which run every \a multiple ticks, indexed
+         * by their phase.
+         */
+        struct TickSchedule {
+            unsigned int multiple;
+            std::vector<ActivityList> phases;
+        };
+        std::vector<TickSchedule> schedules;
+        unsigned long long ticks;
         bool cleanup;
     public:
+        /**
+         * The number of activities for which room is reserved
+         * at construction. More activities may be added.
+         */
     	static const unsigned int MAX_ACTIVITIES = 64;
         /**
          * Create a periodic Timer thread.
@@ -102,8 +122,8 @@ namespace RTT
         virtual ~TimerThread();
 
         /**
-         * Add an Timer that will be ticked every execution period
-         * Once added, a timer can not be removed.
+         * Add an activity that will be stepped on the ticks selected
+         * by its tick multiple and phase.
          */
         bool addActivity( PeriodicActivity* t );
 
@@ -127,6 +147,11 @@ namespace RTT
         virtual void step();
         virtual void finalize();
         void reorderList();
+
+        /**
+         * Returns the list of activities of \a t's multiple and phase.
+         */
+        ActivityList& tickList( PeriodicActivity* t );
         /**
          * A Activity can not create a activity of same priority from step().
          * If so a deadlock will occur.
@@ -16,6 +16,14 @@ namespace RTT {
         template <unsigned S, class T>
         struct MultiVector;
         template<typename T>
+        class LoanPool;
+        template<typename T>
+        struct LoanPoolStorage;
+        template<typename T>
+        struct LoanSlot;
+        template<typename T>
+        class LoanedPointer;
+        template<typename T>
         class ReadOnlyPointer;
         template<typename T>
         struct ROPtrInternal;
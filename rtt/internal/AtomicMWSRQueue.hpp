@@ -41,6 +41,7 @@
 
 #include "../os/CAS.hpp"
 #include <utility>
+#include <cassert>
 
 namespace RTT
 {
@@ -59,7 +60,9 @@ namespace RTT
         class AtomicMWSRQueue
         {
             //typedef _T* T;
-            const int _size;
+            // same type as the indexes, such that they compare without
+            // sign conversions on any target.
+            const os::HalfWord _size;
             typedef T C;
             typedef volatile C* CachePtrType;
             typedef C* volatile CacheObjType;
@@ -76,7 +79,7 @@ namespace RTT
             union SIndexes
             {
                 unsigned long _value;
-                unsigned short _index[2];
+                os::HalfWord _index[2];
             };
 
             /**
@@ -121,6 +124,34 @@ namespace RTT
                 return &_buf[oldval._index[0]];
             }
 
+            /**
+             * Atomic advance and wrap of the Write pointer over
+             * at most \a max free positions.
+             * Returns the old position and the number of positions
+             * in \a n, which is zero if the queue is full.
+             */
+            os::HalfWord advance_w(unsigned int max, unsigned int& n)
+            {
+                SIndexes oldval, newval;
+                do
+                {
+                    oldval._value = _indxes._value;
+                    newval._value = oldval._value;
+                    int used = oldval._index[0] - oldval._index[1];
+                    if (used < 0)
+                        used += _size;
+                    n = _size - 1 - used;
+                    if (n > max)
+                        n = max;
+                    if (n == 0)
+                        return 0;
+                    newval._index[0] = (oldval._index[0] + n) % _size;
+                } while (!os::CAS(&_indxes._value, oldval._value, newval._value));
+                // the n positions from oldval are ours, the reader
+                // stops at the first one we did not write yet.
+                return oldval._index[0];
+            }
+
             /**
              * Advance and wrap of the Read pointer.
              * Only one thread may call this.
@@ -155,6 +186,44 @@ namespace RTT
                 return true;
             }
 
+            /**
+             * Advance the Read pointer over at most \a max
+             * consecutive written elements in one atomic operation.
+             * Only one thread may call this.
+             * @return the number of elements stored in \a result.
+             */
+            unsigned int advance_r(T* result, unsigned int max)
+            {
+                SIndexes oldval, newval;
+                oldval._value = _indxes._value;
+                os::HalfWord r = oldval._index[1];
+                unsigned int n = 0;
+                // collect all elements which were already written.
+                // Cleared slots are 0, so we can never wrap onto
+                // our own elements.
+                while ( n != max ) {
+                    T tmp = _buf[r];
+                    if ( !tmp )
+                        break;
+                    result[n++] = tmp;
+                    _buf[r] = 0;
+                    if ( ++r >= _size )
+                        r = 0;
+                }
+                if ( n == 0 )
+                    return 0;
+
+                // move pointer in one step:
+                do
+                {
+                    oldval._value = _indxes._value;
+                    newval._value = oldval._value;
+                    newval._index[1] = r;
+                } while (!os::CAS(&_indxes._value, oldval._value, newval._value));
+
+                return n;
+            }
+
             // non-copyable !
             AtomicMWSRQueue(const AtomicMWSRQueue<T>&);
         public:
@@ -167,6 +236,7 @@ namespace RTT
             AtomicMWSRQueue(unsigned int size) :
                 _size(size + 1)
             {
+                assert( size < (os::HalfWord) -1 && "AtomicMWSRQueue: size too large for this target." );
                 _buf = new C[_size];
                 this->clear();
             }
@@ -218,7 +288,9 @@ namespace RTT
                 SIndexes val;
                 val._value = _indxes._value;
                 int c = (val._index[0] - val._index[1]);
-                return c >= 0 ? c : c + _size;
+                if (c < 0)
+                    c += _size;
+                return c;
             }
 
             /**
@@ -237,6 +309,30 @@ namespace RTT
                 return true;
             }
 
+            /**
+             * Enqueue at most \a n items in one atomic operation.
+             * This is more efficient than calling enqueue() \a n times,
+             * since the write pointer is only advanced once.
+             * @param values An array of \a n values, which may not
+             * contain null pointers.
+             * @param n The number of values to enqueue.
+             * @return the number of values enqueued, in FIFO order,
+             * which is less than \a n if the queue got full.
+             */
+            size_type enqueue(const T* values, size_type n)
+            {
+                unsigned int count;
+                os::HalfWord w = advance_w(n, count);
+                for (unsigned int i = 0; i != count; ++i)
+                {
+                    assert( values[i] );
+                    _buf[w] = values[i];
+                    if (++w >= _size)
+                        w = 0;
+                }
+                return count;
+            }
+
             /**
              * Dequeue an item.
              * @param value Stores the dequeued value. It is unchanged when
@@ -254,6 +350,21 @@ namespace RTT
                 return false;
             }
 
+            /**
+             * Dequeue at most \a max items in one atomic operation.
+             * This is more efficient than calling dequeue() \a max times,
+             * since the read pointer is only advanced once.
+             * @param result An array of at least \a max elements in which
+             * the dequeued values are stored, in FIFO order.
+             * @param max The maximum number of items to dequeue.
+             * @return the number of items written in \a result, zero if the
+             * queue was empty.
+             */
+            size_type dequeue(T* result, size_type max)
+            {
+                return advance_r(result, max);
+            }
+
             /**
              * Return the next to be read value.
              */
@@ -267,7 +378,7 @@ namespace RTT
              */
             void clear()
             {
-                for (int i = 0; i != _size; ++i)
+                for (os::HalfWord i = 0; i != _size; ++i)
                 {
                     _buf[i] = 0;
                 }
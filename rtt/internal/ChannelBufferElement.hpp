@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/BufferInterface.hpp"
+#include <algorithm>
 
 namespace RTT { namespace internal {
 
@@ -76,6 +77,18 @@ namespace RTT { namespace internal {
             return true;
         }
 
+        /** Appends a batch of samples at the end of the FIFO
+         * with a single call to the buffer.
+         *
+         * @return true, also if only part of the batch fitted in the FIFO.
+         */
+        virtual bool writeBatch(const std::vector<T>& samples)
+        {
+            if (buffer->Push(samples) != 0)
+                return this->signal();
+            return true;
+        }
+
         /** Pops and returns the first element of the FIFO
          *
          * @return false if the FIFO was empty, and true otherwise
@@ -99,6 +112,31 @@ namespace RTT { namespace internal {
             return NoData;
         }
 
+        /** Pops at most \a max elements of the FIFO in one batch.
+         * The last element popped is kept such that a subsequent
+         * read() returns it as OldData.
+         *
+         * @return the number of elements stored in \a samples.
+         */
+        virtual int readBatch(std::vector<T>& samples, int max)
+        {
+            samples.clear();
+            // we are the only reader, so the buffer holds at least
+            // n elements until we pop them.
+            int n = std::min( buffer->size(), max );
+            if ( n <= 0 )
+                return 0;
+            buffer->Pop(samples, n - 1);
+            value_t *new_sample_p;
+            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+                if(last_sample_p)
+                    buffer->Release(last_sample_p);
+                last_sample_p = new_sample_p;
+                samples.push_back( *new_sample_p );
+            }
+            return samples.size();
+        }
+
         /** Removes all elements in the FIFO. After a call to clear(), read()
          * will always return false (provided write() has not been called in the
          * meantime).
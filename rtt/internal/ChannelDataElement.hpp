@@ -69,6 +69,15 @@ namespace RTT { namespace internal {
             return this->signal();
         }
 
+        /** Only the last sample of a batch is kept, so only that
+         * one is written. */
+        virtual bool writeBatch(const std::vector<T>& samples)
+        {
+            if ( samples.empty() )
+                return true;
+            return write( samples.back() );
+        }
+
         /** Reads the last sample given to write()
          *
          * @return false if no sample has ever been written, true otherwise
@@ -0,0 +1,259 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  ChannelSharedDataElement.hpp
+
+                        ChannelSharedDataElement.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_CHANNEL_SHARED_DATA_ELEMENT_HPP
+#define ORO_CHANNEL_SHARED_DATA_ELEMENT_HPP
+
+#include "../base/ChannelElement.hpp"
+#include "../base/DataObjectInterface.hpp"
+#include "../os/Atomic.hpp"
+#include <boost/shared_ptr.hpp>
+
+namespace RTT { namespace internal {
+
+    /**
+     * The single data sample that is shared by all ConnPolicy::SHARED_DATA
+     * connections of one OutputPort. The port writes each sample once
+     * in this storage and every reader of the fan-out keeps its own
+     * cursor on the sample sequence number.
+     */
+    template<typename T>
+    class SharedDataStorage
+    {
+        typename base::DataObjectInterface<T>::shared_ptr data;
+        os::AtomicInt seq;
+        int mlock_policy;
+        int mmax_readers;
+        os::AtomicInt mreaders;
+
+        SharedDataStorage(SharedDataStorage const&);
+        SharedDataStorage& operator=(SharedDataStorage const&);
+    public:
+        typedef boost::shared_ptr< SharedDataStorage<T> > shared_ptr;
+
+        /**
+         * @param sample The data object that holds the shared sample.
+         * @param lock_policy The ConnPolicy lock policy \a sample was built for.
+         * @param max_readers The number of readers \a sample supports,
+         * zero if unlimited.
+         */
+        SharedDataStorage(typename base::DataObjectInterface<T>::shared_ptr sample, int lock_policy, int max_readers)
+            : data(sample), seq(0), mlock_policy(lock_policy), mmax_readers(max_readers), mreaders(0) {}
+
+        /**
+         * The lock policy this storage was created with.
+         */
+        int getLockPolicy() const
+        {
+            return mlock_policy;
+        }
+
+        /**
+         * The number of readers this storage supports, zero if unlimited.
+         */
+        int getMaxReaders() const
+        {
+            return mmax_readers;
+        }
+
+        /**
+         * Reserves a reader for a new connection.
+         * @return false if all readers are taken.
+         */
+        bool addReader()
+        {
+            if ( mmax_readers == 0 )
+                return true;
+            // concurrent calls may both fail on the last reader,
+            // but never both succeed.
+            mreaders.inc();
+            if ( mreaders.read() > mmax_readers ) {
+                mreaders.dec();
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Releases a reader reserved with addReader().
+         */
+        void removeReader()
+        {
+            if ( mmax_readers != 0 )
+                mreaders.dec();
+        }
+
+        /**
+         * Stores a new sample. There may be only one writer.
+         */
+        void write(typename base::ChannelElement<T>::param_t sample)
+        {
+            data->Set(sample);
+            seq.inc();
+        }
+
+        /**
+         * Copies the stored sample into \a sample.
+         */
+        void get(typename base::ChannelElement<T>::reference_t sample) const
+        {
+            data->Get(sample);
+        }
+
+        T get() const
+        {
+            return data->Get();
+        }
+
+        void data_sample(typename base::ChannelElement<T>::param_t sample)
+        {
+            data->data_sample(sample);
+        }
+
+        /**
+         * Returns the number of samples written so far, zero if none.
+         */
+        int sequence()
+        {
+            return seq.read();
+        }
+    };
+
+    /**
+     * A connection element that reads from a SharedDataStorage which
+     * it shares with the other ConnPolicy::SHARED_DATA connections of the
+     * same OutputPort. The OutputPort fills in the storage once per write()
+     * and only signals this element, such that a write costs one copy
+     * regardless of the number of readers. Each element remembers which
+     * sample its reader saw last, so NewData and OldData are reported per
+     * reader, as with a ChannelDataElement.
+     */
+    template<typename T>
+    class ChannelSharedDataElement : public base::ChannelElement<T>
+    {
+        typename SharedDataStorage<T>::shared_ptr storage;
+        int last;
+        bool mread;
+
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+
+        /**
+         * Creates a new reader on \a shared. Samples written before
+         * this element was created are not reported, unless the
+         * connection is initialized with write().
+         * The reader must have been reserved with SharedDataStorage::addReader(),
+         * it is released when this element is destroyed.
+         */
+        ChannelSharedDataElement(typename SharedDataStorage<T>::shared_ptr shared)
+            : storage(shared), last( shared->sequence() ), mread(false) {}
+
+        ~ChannelSharedDataElement()
+        {
+            storage->removeReader();
+        }
+
+        /**
+         * Only used to initialize this connection with the
+         * last written value of the port. If the storage has
+         * already been written by the port, it is not written
+         * again and only this reader will see it as NewData.
+         */
+        virtual bool write(param_t sample)
+        {
+            if ( storage->sequence() == 0 )
+                storage->write(sample);
+            last = storage->sequence() - 1;
+            return this->signal();
+        }
+
+        /**
+         * Reads the last sample written in the shared storage.
+         * If the port writes during this read, the newer sample
+         * may be returned and reported once more as NewData on
+         * the next read, but it is never lost.
+         */
+        virtual FlowStatus read(reference_t sample, bool copy_old_data)
+        {
+            int current = storage->sequence();
+            if ( current != last ) {
+                storage->get(sample);
+                last = current;
+                mread = true;
+                return NewData;
+            }
+            if ( mread ) {
+                if (copy_old_data)
+                    storage->get(sample);
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** After clear() has been called, read() returns NoData until
+         * the port writes a new sample.
+         */
+        virtual void clear()
+        {
+            last = storage->sequence();
+            mread = false;
+            base::ChannelElement<T>::clear();
+        }
+
+        /**
+         * The sample is only passed on to the shared storage as long as
+         * nothing was written in it, since other readers may be reading it.
+         */
+        virtual bool data_sample(param_t sample)
+        {
+            if ( storage->sequence() == 0 )
+                storage->data_sample(sample);
+            return base::ChannelElement<T>::data_sample(sample);
+        }
+
+        virtual T data_sample()
+        {
+            return storage->get();
+        }
+
+    };
+}}
+
+#endif
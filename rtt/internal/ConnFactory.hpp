@@ -138,16 +138,27 @@ namespace RTT
         template<typename T>
         static base::ChannelElementBase* buildDataStorage(ConnPolicy const& policy, const T& initial_value = T())
         {
-            if (policy.type == ConnPolicy::DATA)
+            // A SHARED_DATA storage that is built on its own (for example by a
+            // transport) has nothing to be shared with, so it is a plain DATA storage.
+            if (policy.type == ConnPolicy::DATA || policy.type == ConnPolicy::SHARED_DATA)
             {
                 typename base::DataObjectInterface<T>::shared_ptr data_object;
                 switch (policy.lock_policy)
                 {
 #ifndef OROBLD_OS_NO_ASM
+                case ConnPolicy::SEQLOCK:
+                    if ( boost::is_pod<T>::value ) {
+                        data_object.reset( new base::DataObjectSeqLock<T>(initial_value) );
+                        break;
+                    }
+                    // other types can not be copied while they are written.
+                case ConnPolicy::SPSC:
                 case ConnPolicy::LOCK_FREE:
                     data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
                     break;
 #else
+                case ConnPolicy::SEQLOCK:
+                case ConnPolicy::SPSC:
 		case ConnPolicy::LOCK_FREE:
 		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
 #endif
@@ -168,10 +179,19 @@ namespace RTT
                 switch (policy.lock_policy)
                 {
 #ifndef OROBLD_OS_NO_ASM
+                case ConnPolicy::SPSC:
+                    if (policy.type == ConnPolicy::BUFFER) {
+                        buffer_object = new base::BufferSPSC<T>(policy.size, initial_value);
+                        break;
+                    }
+                    // a circular buffer needs a writer which drops samples.
+                case ConnPolicy::SEQLOCK:
                 case ConnPolicy::LOCK_FREE:
                     buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
                     break;
 #else
+                case ConnPolicy::SEQLOCK:
+                case ConnPolicy::SPSC:
 		case ConnPolicy::LOCK_FREE:
 		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
 #endif
@@ -187,6 +207,55 @@ namespace RTT
             return NULL;
         }
 
+        /**
+         * The minimum number of readers of a lock-free SharedDataStorage.
+         */
+        enum { MinSharedReaders = 8 };
+
+        /**
+         * Creates the storage that is shared by all ConnPolicy::SHARED_DATA
+         * connections of one output port.
+         * @param policy The policy of the first shared connection. Its lock_policy
+         * is used for the storage. A lock-free storage supports \a policy.size
+         * readers, but at least MinSharedReaders.
+         * @param initial_value The value to initialize the storage with.
+         */
+        template<typename T>
+        static SharedDataStorage<T>* buildSharedDataStorage(ConnPolicy const& policy, const T& initial_value = T())
+        {
+            typename base::DataObjectInterface<T>::shared_ptr data_object;
+            int max_readers = 0;
+            switch (policy.lock_policy)
+            {
+#ifndef OROBLD_OS_NO_ASM
+            case ConnPolicy::SEQLOCK:
+                // any number of readers.
+                if ( boost::is_pod<T>::value ) {
+                    data_object.reset( new base::DataObjectSeqLock<T>(initial_value) );
+                    break;
+                }
+            case ConnPolicy::SPSC: // shared data has more than one reader.
+            case ConnPolicy::LOCK_FREE:
+                // one writer and max_readers readers.
+                max_readers = policy.size > MinSharedReaders ? policy.size : MinSharedReaders;
+                data_object.reset( new base::DataObjectLockFree<T>(initial_value, max_readers + 1 ) );
+                break;
+#else
+            case ConnPolicy::SEQLOCK:
+            case ConnPolicy::SPSC:
+            case ConnPolicy::LOCK_FREE:
+                RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
+#endif
+            case ConnPolicy::LOCKED:
+                data_object.reset( new base::DataObjectLocked<T>(initial_value) );
+                break;
+            case ConnPolicy::UNSYNC:
+                data_object.reset( new base::DataObjectUnSync<T>(initial_value) );
+                break;
+            }
+            return new SharedDataStorage<T>(data_object, policy.lock_policy, max_readers);
+        }
+
         /** During the process of building a connection between two ports, this
          * method builds the input half (starting from the OutputPort).
          *
@@ -261,6 +330,41 @@ namespace RTT
             return data_object;
         }
 
+        /**
+         * Builds the output half of a local ConnPolicy::SHARED_DATA connection.
+         * The first shared connection of \a output_port creates the storage
+         * that all its next shared connections read from. A next connection
+         * is refused if its lock policy differs from the storage's or if
+         * the storage has no reader left.
+         * @param output_port The output port that writes into the shared storage.
+         * @param port The input port to which the connection is added.
+         * @param conn_id A unique connection id which identifies this connection
+         * @param policy The policy of this connection.
+         */
+        template<typename T>
+        static base::ChannelElementBase::shared_ptr buildSharedChannelOutput(OutputPort<T>& output_port, InputPort<T>& port, ConnID* conn_id, ConnPolicy const& policy)
+        {
+            assert(conn_id);
+            if ( !output_port.shared_data )
+                output_port.shared_data.reset( buildSharedDataStorage<T>(policy, output_port.getLastWrittenValue()) );
+            else if ( output_port.shared_data->getLockPolicy() != policy.lock_policy ) {
+                log(Error) << "Can not connect " << output_port.getName() << " to " << port.getName()
+                           << ": its shared data connections use lock policy " << output_port.shared_data->getLockPolicy()
+                           << ", not " << policy.lock_policy << "." << endlog();
+                return 0;
+            }
+            if ( !output_port.shared_data->addReader() ) {
+                log(Error) << "Can not connect " << output_port.getName() << " to " << port.getName()
+                           << ": its shared data storage supports only " << output_port.shared_data->getMaxReaders()
+                           << " readers. Set the size of the first shared connection's policy to the number of readers." << endlog();
+                return 0;
+            }
+            base::ChannelElementBase::shared_ptr endpoint = new ConnOutputEndpoint<T>(&port, conn_id);
+            base::ChannelElementBase::shared_ptr data_object = new ChannelSharedDataElement<T>(output_port.shared_data);
+            data_object->setOutput(endpoint);
+            return data_object;
+        }
+
         /**
          * Creates a connection from a local output_port to a local or remote input_port.
          * This function contains all logic to decide on how connections must be created to
@@ -291,10 +395,23 @@ namespace RTT
                     return false;
                 }
                 // local ports, create buffer here.
-                output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
+                if (policy.type == ConnPolicy::SHARED_DATA)
+                    output_half = buildSharedChannelOutput<T>(output_port, *input_p, output_port.getPortID(), policy);
+                else
+                    output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
             }
             else
             {
+                if (policy.type == ConnPolicy::SHARED_DATA) {
+                    // The sample can only be shared within this process.
+                    log(Info) << "Connecting " << output_port.getName() << " to " << input_port.getName() << " with a DATA instead of a SHARED_DATA connection." <<endlog();
+                    ConnPolicy data_policy = policy;
+                    data_policy.type = ConnPolicy::DATA;
+                    data_policy.size = 0;
+                    bool result = createConnection(output_port, input_port, data_policy);
+                    policy.name_id = data_policy.name_id;
+                    return result;
+                }
                 // if the input is not local, this is a pure remote connection,
                 // if the input *is* local, the user requested to use a different transport
                 // than plain memory, rare case, but we accept it. The unit tests use this for example
@@ -75,6 +75,16 @@ namespace RTT
             return true;
         }
 
+        /** Hands the batch over in one call to the next element,
+         * such that a buffer can store it at once. */
+        virtual bool writeBatch(const std::vector<T>& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->writeBatch(samples);
+            return false;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class first
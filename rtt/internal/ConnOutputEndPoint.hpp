@@ -99,6 +99,17 @@ namespace RTT
         virtual bool write(typename base::ChannelElement<T>::param_t sample)
         { return false; }
 
+        /** Reads the batch in one call from the previous element,
+         * such that a buffer can return it at once. */
+        virtual int readBatch(std::vector<T>& samples, int max)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readBatch(samples, max);
+            samples.clear();
+            return 0;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class: it does the common cleanup
@@ -59,7 +59,7 @@ namespace RTT
     {
 
         ConnectionManager::ConnectionManager(PortInterface* port)
-            : mport(port)
+            : mport(port), connections(0), cur_channel(0), retired(MaxRetiredChannels)
         {
         }
 
@@ -68,6 +68,33 @@ namespace RTT
             this->disconnect();
         }
 
+        void ConnectionManager::releaseRetired()
+        {
+            // first drop the copies in the list, such that ours are the
+            // last references to the retired channels.
+            connections.purge();
+            base::ChannelElementBase* channel;
+            while ( retired.dequeue( channel ) )
+                intrusive_ptr_release( channel );
+        }
+
+        /**
+         * Helper function to find the current channel.
+         */
+        void findChannel(base::ChannelElementBase* current, base::ChannelElementBase::shared_ptr* result, ConnectionManager::ChannelDescriptor& descriptor) {
+            if ( !*result || descriptor.get<1>().get() == current )
+                *result = descriptor.get<1>();
+        }
+
+        base::ChannelElementBase::shared_ptr ConnectionManager::getCurrentChannel() const
+        {
+            // only hand out channels which are still in the list,
+            // the current one may have been removed.
+            base::ChannelElementBase::shared_ptr result;
+            connections.apply( boost::bind(&findChannel, cur_channel, &result, _1) );
+            return result;
+        }
+
         /**
          * Helper function to clear a connection.
          * @param descriptor
@@ -76,22 +103,28 @@ namespace RTT
             descriptor.get<1>()->clear();
         }
 
+        /**
+         * Helper function to copy a connection.
+         */
+        void copyChannel(std::list<ConnectionManager::ChannelDescriptor>* result, ConnectionManager::ChannelDescriptor& descriptor) {
+            result->push_back( descriptor );
+        }
+
         void ConnectionManager::clear()
-        { RTT::os::MutexLock lock(connection_lock);
-            std::for_each(connections.begin(), connections.end(), &clearChannel);
+        {
+            connections.apply( &clearChannel );
         }
 
-        bool ConnectionManager::findMatchingPort(ConnID const* conn_id, ChannelDescriptor const& descriptor)
+        std::list<ConnectionManager::ChannelDescriptor> ConnectionManager::getChannels() const
         {
-            return ( descriptor.get<0>() && conn_id->isSameID(*descriptor.get<0>()));
+            std::list<ChannelDescriptor> result;
+            connections.apply( boost::bind(&copyChannel, &result, _1) );
+            return result;
         }
 
-        void ConnectionManager::updateCurrentChannel(bool reset_current)
+        bool ConnectionManager::findMatchingPort(ConnID const* conn_id, ChannelDescriptor const& descriptor)
         {
-            if (connections.empty())
-                cur_channel = ChannelDescriptor();
-            else if (reset_current)
-                cur_channel = connections.front();
+            return ( descriptor.get<0>() && conn_id->isSameID(*descriptor.get<0>()));
         }
 
         bool ConnectionManager::disconnect(PortInterface* port)
@@ -115,8 +148,11 @@ namespace RTT
         {
             std::list<ChannelDescriptor> all_connections;
             { RTT::os::MutexLock lock(connection_lock);
-                all_connections.splice(all_connections.end(), connections);
-                cur_channel = ChannelDescriptor();
+                all_connections = getChannels();
+                connections.clear();
+                connections.shrink( all_connections.size() );
+                cur_channel = 0;
+                releaseRetired();
             }
             std::for_each(all_connections.begin(), all_connections.end(),
                     boost::bind(&ConnectionManager::eraseConnection, this, _1));
@@ -130,22 +166,27 @@ namespace RTT
         { RTT::os::MutexLock lock(connection_lock);
             assert(conn_id);
             ChannelDescriptor descriptor = boost::make_tuple(conn_id, channel, policy);
+            // allocates here, such that the real-time side never needs to.
+            connections.grow(1);
             if (connections.empty())
-                cur_channel = descriptor;
-            connections.push_back(descriptor);
+                cur_channel = channel.get();
+            connections.append(descriptor);
+            releaseRetired();
         }
 
         bool ConnectionManager::removeConnection(ConnID* conn_id)
         {
             ChannelDescriptor descriptor;
             { RTT::os::MutexLock lock(connection_lock);
-                std::list<ChannelDescriptor>::iterator conn_it =
-                    std::find_if(connections.begin(), connections.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
-                if (conn_it == connections.end())
+                descriptor = connections.find_if( boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1) );
+                if ( !descriptor.get<1>() )
                     return false;
-                descriptor = *conn_it;
-                connections.erase(conn_it);
-                updateCurrentChannel( cur_channel.get<1>() == descriptor.get<1>() );
+                connections.delete_if( boost::bind(&ConnectionManager::isChannel, descriptor.get<1>().get(), _1) );
+                connections.shrink(1);
+                // the reader moves to the next channel by itself.
+                if ( cur_channel == descriptor.get<1>().get() )
+                    cur_channel = 0;
+                releaseRetired();
             }
 
             // disconnect needs to know if we're from Out->In (forward) or from In->Out
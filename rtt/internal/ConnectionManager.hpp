@@ -49,6 +49,7 @@
 
 #include "ConnID.hpp"
 #include "List.hpp"
+#include "AtomicQueue.hpp"
 #include "../ConnPolicy.hpp"
 #include "../os/Mutex.hpp"
 #include "../base/rtt-base-fwd.hpp"
@@ -72,7 +73,15 @@ namespace RTT
          * Manages connections between ports.
          * This class is used for input and output ports
          * in order to manage their channels.
-         * TODO: use the mutex lock !!!
+         *
+         * The connections are kept in a copy-on-write List. The real-time
+         * side (reading, writing and clearing the port) traverses a snapshot
+         * of that list and never takes a lock, such that adding or removing
+         * connections at runtime can not cause priority inversion on it.
+         * The channels which the real-time side removes are only released
+         * on the next connect or disconnect, which also destroys the
+         * stale copies of the list, such that channels are never destroyed
+         * in the real-time thread.
          */
         class RTT_API ConnectionManager
         {
@@ -115,21 +124,32 @@ namespace RTT
             /** Removes the channel that connects this port to \c port */
             bool disconnect(base::PortInterface* port);
 
+            /**
+             * Calls \a pred once for each connection and removes the
+             * connections for which it returned true.
+             * The removed channels are kept alive until the next connect
+             * or disconnect, which releases them outside the real-time thread.
+             * @note Never blocks nor frees memory.
+             */
             template<typename Pred>
             bool delete_if(Pred pred) {
-                RTT::os::MutexLock lock(connection_lock);
-                bool result = false;
-                std::list<ChannelDescriptor>::iterator it = connections.begin();
-                while (it != connections.end())
-                {
-                    if (pred(*it))
-                    {
-                        result = true;
-                        it = connections.erase(it);
+                base::ChannelElementBase* failed[MaxFailedChannels];
+                unsigned int nfailed = 0;
+                connections.apply( ApplyAndCollect<Pred>(pred, failed, nfailed) );
+                for (unsigned int i = 0; i != nfailed; ++i) {
+                    // the list still holds the channel, so this reference
+                    // is never the last one.
+                    intrusive_ptr_add_ref( failed[i] );
+                    if ( !retired.enqueue( failed[i] ) ) {
+                        // removed by a later call.
+                        intrusive_ptr_release( failed[i] );
+                        continue;
                     }
-                    else ++it;
+                    if ( cur_channel == failed[i] )
+                        cur_channel = 0;
+                    connections.delete_if( boost::bind(&ConnectionManager::isChannel, failed[i], ::_1) );
                 }
-                return result;
+                return nfailed != 0;
             }
 
             /**
@@ -139,36 +159,32 @@ namespace RTT
              * does not satisfy pred, iterate over \b all connections.
              * If none satisfy pred, the current channel remains unchanged.
              * @param pred
+             * @note Never blocks.
              */
             template<typename Pred>
             void select_reader_channel(Pred pred, bool copy_old_data) {
-                RTT::os::MutexLock lock(connection_lock);
-                std::pair<bool, ChannelDescriptor> new_channel =
-                    find_if(pred, copy_old_data);
-                if (new_channel.first)
-                {
-                    // We don't clear the current channel (to get it to NoData state), because there is a race
-                    // between find_if and this line. We have to accept (in other parts of the code) that eventually,
-                    // all channels return 'OldData'.
-                    cur_channel = new_channel.second;
+                // We don't clear the current channel (to get it to NoData state), because there is a race
+                // between the two passes. We have to accept (in other parts of the code) that eventually,
+                // all channels return 'OldData'.
+                bool selected = false;
+                base::ChannelElementBase* current = cur_channel;
+                base::ChannelElementBase* front = 0;
+                bool present = false;
+                connections.apply( TryCurrent<Pred>(pred, copy_old_data, current, front, present, selected) );
+                // the current channel was removed, the first one takes over.
+                if ( !present && front ) {
+                    cur_channel = current = front;
+                    connections.apply( TryCurrent<Pred>(pred, copy_old_data, current, front, present, selected) );
+                }
+                if ( !selected ) {
+                    // We only copy OldData in the initial read of the current channel.
+                    // if it has no new data, the search over the other channels starts,
+                    // but no old data is needed.
+                    base::ChannelElementBase* found = 0;
+                    connections.apply( FindFirst<Pred>(pred, found) );
+                    if ( found )
+                        cur_channel = found;
                 }
-            }
-
-            template<typename Pred>
-            std::pair<bool, ChannelDescriptor> find_if(Pred pred, bool copy_old_data) {
-                // We only copy OldData in the initial read of the current channel.
-                // if it has no new data, the search over the other channels starts,
-                // but no old data is needed.
-                ChannelDescriptor channel = cur_channel;
-                if ( channel.get<1>() )
-                    if ( pred( copy_old_data, channel ) )
-                        return std::make_pair(true, channel);
-
-                std::list<ChannelDescriptor>::iterator result;
-                for (result = connections.begin(); result != connections.end(); ++result)
-                    if ( pred(false, *result) == true)
-                        return std::make_pair(true, *result);
-                return std::make_pair(false, ChannelDescriptor());
             }
 
             /**
@@ -180,18 +196,14 @@ namespace RTT
             /**
              * Returns the first added channel or if select_if was called, the selected channel.
              * @see select_if to change the current channel.
-             * @return
+             * @return A null pointer if not connected.
              */
-            base::ChannelElementBase* getCurrentChannel() const {
-                return cur_channel.get<1>().get();
-            }
+            base::ChannelElementBase::shared_ptr getCurrentChannel() const;
 
             /**
              * Returns a list of all channels managed by this object.
              */
-            std::list<ChannelDescriptor> getChannels() const {
-                return connections;
-            }
+            std::list<ChannelDescriptor> getChannels() const;
 
             /**
              * Clears (removes) all data in the manager's connections.
@@ -201,8 +213,79 @@ namespace RTT
             void clear();
 
         protected:
+            /**
+             * The number of channels that one delete_if() call removes.
+             * The next failing channels are removed by a later call.
+             */
+            static const unsigned int MaxFailedChannels = 4;
+
+            /**
+             * The number of channels that delete_if() can remove
+             * between two connects or disconnects.
+             */
+            static const unsigned int MaxRetiredChannels = 16;
 
-            void updateCurrentChannel(bool reset_current);
+            /**
+             * Releases the channels removed by delete_if() and the
+             * stale copies of the connections list.
+             * Call with connection_lock locked.
+             */
+            void releaseRetired();
+
+            /** Returns true if \a descriptor contains \a channel. */
+            static bool isChannel(base::ChannelElementBase* channel, ChannelDescriptor const& descriptor) {
+                return descriptor.get<1>().get() == channel;
+            }
+
+            /** Helper functor for delete_if(). */
+            template<typename Pred>
+            struct ApplyAndCollect {
+                Pred& pred;
+                base::ChannelElementBase** failed;
+                unsigned int& nfailed;
+                ApplyAndCollect(Pred& p, base::ChannelElementBase** f, unsigned int& n)
+                    : pred(p), failed(f), nfailed(n) {}
+                void operator()(ChannelDescriptor& descriptor) {
+                    if ( pred(descriptor) && nfailed != MaxFailedChannels )
+                        failed[nfailed++] = descriptor.get<1>().get();
+                }
+            };
+
+            /** Helper functor for select_reader_channel(), which tries
+             * the current channel and records the first channel. */
+            template<typename Pred>
+            struct TryCurrent {
+                Pred& pred;
+                bool copy_old_data;
+                base::ChannelElementBase* current;
+                base::ChannelElementBase*& front;
+                bool& present;
+                bool& selected;
+                TryCurrent(Pred& p, bool c, base::ChannelElementBase* cur, base::ChannelElementBase*& f, bool& pr, bool& s)
+                    : pred(p), copy_old_data(c), current(cur), front(f), present(pr), selected(s) { front = 0; }
+                void operator()(ChannelDescriptor& descriptor) {
+                    if ( !front )
+                        front = descriptor.get<1>().get();
+                    if ( descriptor.get<1>().get() == current ) {
+                        present = true;
+                        selected = pred( copy_old_data, descriptor );
+                    }
+                }
+            };
+
+            /** Helper functor for select_reader_channel(), which finds
+             * the first channel that satisfies the predicate. */
+            template<typename Pred>
+            struct FindFirst {
+                Pred& pred;
+                base::ChannelElementBase*& found;
+                FindFirst(Pred& p, base::ChannelElementBase*& f)
+                    : pred(p), found(f) {}
+                void operator()(ChannelDescriptor& descriptor) {
+                    if ( !found && pred(false, descriptor) )
+                        found = descriptor.get<1>().get();
+                }
+            };
 
             /** Helper method for disconnect(PortInterface*)
              *
@@ -229,19 +312,26 @@ namespace RTT
             base::PortInterface* mport;
 
             /**
-             * A list of all our connections. Only non-null if two or more connections
-             * were added.
+             * A list of all our connections.
+             */
+            mutable List< ChannelDescriptor > connections;
+
+            /**
+             * The channel which is read first. Only used to identify
+             * the channel in \a connections, it does not keep it alive.
+             * It is reset when that channel is removed.
              */
-            std::list< ChannelDescriptor > connections;
+            base::ChannelElementBase* volatile cur_channel;
 
             /**
-             * Optimisation in case only one channel is to be managed.
+             * The channels removed by delete_if(), each holding one
+             * reference which is released by releaseRetired().
              */
-            ChannelDescriptor cur_channel;
+            AtomicQueue<base::ChannelElementBase*> retired;
 
             /**
-             * Lock that should be taken before the list of connections is
-             * accessed or modified
+             * Lock that serializes adding and removing connections.
+             * It is never taken by the real-time side.
              */
             RTT::os::Mutex connection_lock;
         };
@@ -239,6 +239,24 @@ namespace RTT
             required -= items;
         }
 
+        /**
+         * Destroys the elements which the unused buffers still hold
+         * from former versions of the list. Otherwise, they are only
+         * destroyed when a buffer is reused, which may happen in
+         * a real-time thread that modifies the list.
+         * @note This function is only real-time if the destructor of \a T is real-time.
+         */
+        void purge() {
+            Storage bufptr = bufs;
+            for (unsigned int i = 0; i != BufNum(); ++i) {
+                Item* it = &(*bufptr)[i];
+                // claim the buffer as findEmptyBuf() does.
+                if ( oro_atomic_inc_and_test( &it->count ) )
+                    it->data.clear();
+                oro_atomic_dec( &it->count );
+            }
+        }
+
         /**
          * Reserve a capacity for this list.
          * If you wish to invoke this method concurrently, guard it
@@ -154,6 +154,13 @@ namespace RTT
             required -= items;
         }
 
+        /**
+         * Does nothing, since this list destroys its elements
+         * as soon as they are removed.
+         */
+        void purge() {
+        }
+
         /**
          * Reserve a capacity for this list.
          * @param lsize the \a minimal number of items this list will be
@@ -104,7 +104,7 @@ namespace RTT
                         this->reportError();
                     bool result = false;
                     if ( this->caller){
-                        result = this->caller->process(this);
+                        result = this->caller->process(this, this->caller->getSendLane());
                     }
                     if (!result)
                         dispose();
@@ -135,7 +135,9 @@ namespace RTT
             SendHandle<Signature> do_send(shared_ptr cl) {
                 assert(this->myengine); // myengine must be either the caller's engine or GlobalEngine::Instance().
                 //std::cout << "Sending clone..."<<std::endl;
-                if ( this->myengine->process( cl.get() ) ) {
+                // the caller decides in which lane its messages are queued.
+                ExecutionEngine::Lane lane = this->caller ? this->caller->getSendLane() : ExecutionEngine::NormalLane;
+                if ( this->myengine->process( cl.get(), lane ) ) {
                     cl->self = cl;
                     return SendHandle<Signature>( cl );
                 } else {
@@ -154,6 +154,24 @@ namespace RTT
             return true;
         }
 
+        /**
+         * Dequeue at most \a max items while holding the lock once.
+         * @param result An array of at least \a max elements in which
+         * the dequeued values are stored, in FIFO order.
+         * @param max The maximum number of items to dequeue.
+         * @return the number of items written in \a result.
+         */
+        size_type dequeue( T* result, size_type max )
+        {
+            os::MutexLock locker(lock);
+            size_type n = 0;
+            while ( n != max && !data.empty() ) {
+                result[n++] = data.front();
+                data.pop_front();
+            }
+            return n;
+        }
+
         /**
          * Returns the first element of the queue.
          */
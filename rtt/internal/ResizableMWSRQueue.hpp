@@ -0,0 +1,276 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  ResizableMWSRQueue.hpp
+
+                        ResizableMWSRQueue.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_RESIZABLE_MWSR_QUEUE_HPP
+#define ORO_RESIZABLE_MWSR_QUEUE_HPP
+
+#include "MWSRQueue.hpp"
+#include "../os/Atomic.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/MutexLock.hpp"
+#include "../os/fosi.h"
+
+namespace RTT
+{
+    namespace internal
+    {
+
+        /**
+         * A Multi-Writer, Single-Reader queue of which the capacity can
+         * be changed while it is in use, without blocking the writers or
+         * the reader.
+         *
+         * A resize() installs a new MWSRQueue in which the writers continue.
+         * The reader first empties the old queue and then continues in the
+         * new one, such that the order of the items of each writer is
+         * preserved. The old queue is deleted by the next resize(),
+         * such that neither enqueue() nor dequeue() ever allocate or free
+         * memory.
+         *
+         * @param T A pointer type, as required by MWSRQueue.
+         */
+        template<class T>
+        class ResizableMWSRQueue
+        {
+        public:
+            typedef MWSRQueue<T> QueueType;
+            typedef unsigned int size_type;
+
+            /**
+             * Create a queue which can initially hold \a size items.
+             */
+            ResizableMWSRQueue(size_type size)
+                : win( new QueueType(size) ), rout( win ), sealed(0), retired(0),
+                  cap(size), epoch(0)
+            {
+            }
+
+            ~ResizableMWSRQueue()
+            {
+                if ( rout != win )
+                    delete rout;
+                delete win;
+                delete retired;
+            }
+
+            /**
+             * Replaces the queue by one that can hold \a size items.
+             * The items in the current queue remain available to the
+             * reader. This function waits until all writers that are
+             * enqueueing in the old queue have finished, and may thus
+             * not be called from a real-time thread.
+             * @return false if the reader did not yet empty the queue
+             * of a previous resize(), or \a size is zero.
+             */
+            bool resize(size_type size)
+            {
+                if ( size == 0 )
+                    return false;
+                os::MutexLock lock( resize_lock );
+                if ( rout != win )
+                    return false;
+                delete retired;
+                retired = 0;
+
+                QueueType* old = win;
+                QueueType* nq = new QueueType(size);
+                // atomic, such that nq is constructed before it is published.
+                resizes.inc();
+                win = nq;
+                cap = size;
+                // new writers now count in the other epoch, the ones of
+                // the current epoch may still be writing in the old queue.
+                int e = epoch.read() & 1;
+                epoch.inc();
+                while ( writers[e].read() != 0 ) {
+                    TIME_SPEC ts;
+                    ts.tv_sec = 0;
+                    ts.tv_nsec = 100*1000;
+                    rtos_nanosleep( &ts, 0 );
+                }
+                sealed = old;
+                return true;
+            }
+
+            /**
+             * Inspect if resize() would accept a new size, that is,
+             * if the reader emptied the queue of a previous resize().
+             */
+            bool isResizable() const
+            {
+                return rout == win;
+            }
+
+            /**
+             * Return the maximum number of items new writers can queue.
+             */
+            size_type capacity() const
+            {
+                return cap;
+            }
+
+            /**
+             * Return the number of items in the queue.
+             * May only be called by the reader.
+             */
+            size_type size() const
+            {
+                QueueType* q = rout;
+                if ( q != win )
+                    return q->size() + win->size();
+                return q->size();
+            }
+
+            /**
+             * Inspect if the Queue is empty.
+             * May only be called by the reader.
+             */
+            bool isEmpty() const
+            {
+                QueueType* q = rout;
+                return q->isEmpty() && ( q == win || win->isEmpty() );
+            }
+
+            /**
+             * Inspect if the Queue is full for new writers.
+             */
+            bool isFull() const
+            {
+                return win->isFull();
+            }
+
+            /**
+             * Return the number of times this queue was resized.
+             */
+            int resizeCount()
+            {
+                return resizes.read();
+            }
+
+            /**
+             * Enqueue an item.
+             * @param value The value to enqueue.
+             * @return false if queue is full, true if queued.
+             */
+            bool enqueue(const T& value)
+            {
+                int e = epoch.read() & 1;
+                writers[e].inc();
+                bool result = win->enqueue( value );
+                writers[e].dec();
+                return result;
+            }
+
+            /**
+             * Dequeue an item.
+             * @param result Stores the dequeued value.
+             * @return false if queue is empty, true if result was written.
+             */
+            bool dequeue(T& result)
+            {
+                do {
+                    if ( rout->dequeue( result ) )
+                        return true;
+                } while ( advance() );
+                return false;
+            }
+
+            /**
+             * Dequeue at most \a max items at once.
+             * @param result An array of at least \a max elements.
+             * @return the number of items written in \a result.
+             */
+            size_type dequeue(T* result, size_type max)
+            {
+                size_type n;
+                do {
+                    n = rout->dequeue( result, max );
+                    if ( n != 0 )
+                        return n;
+                } while ( advance() );
+                return 0;
+            }
+
+            /**
+             * Lets the reader move on to the queue installed by resize()
+             * if the old queue is empty. dequeue() does this implicitly,
+             * readers that only inspect the size() should call this first.
+             */
+            void refresh()
+            {
+                advance();
+            }
+
+        private:
+            /**
+             * Moves the reader to the new queue once the old one
+             * is sealed and empty.
+             * @return true if the reader should try to dequeue again.
+             */
+            bool advance()
+            {
+                QueueType* q = rout;
+                if ( sealed != q )
+                    return false;
+                // a last writer may have finished after our dequeue.
+                if ( !q->isEmpty() )
+                    return true;
+                sealed = 0;
+                retired = q;
+                rout = win;
+                return true;
+            }
+
+            /** The queue in which writers enqueue. */
+            QueueType* volatile win;
+            /** The queue from which the reader dequeues. */
+            QueueType* volatile rout;
+            /** Set to rout when no writer can enqueue in it anymore. */
+            QueueType* volatile sealed;
+            /** The emptied queue, deleted by the next resize(). */
+            QueueType* volatile retired;
+            volatile size_type cap;
+            os::AtomicInt epoch;
+            os::AtomicInt writers[2];
+            os::AtomicInt resizes;
+            os::Mutex resize_lock;
+        };
+    }
+}
+
+#endif
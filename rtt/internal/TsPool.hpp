@@ -47,6 +47,7 @@
 #define RTT_TSPOOL_HPP_
 
 #include "../os/CAS.hpp"
+#include "../os/Atomic.hpp"
 #include <assert.h>
 
 namespace RTT
@@ -56,7 +57,11 @@ namespace RTT
 
         /**
          * A multi-reader multi-writer MemoryPool implementation.
-         * It can hold max 65535 elements of type T.
+         * The free list is a tagged index which is swapped in one word,
+         * so the pool can hold at most 65534 elements of type T on targets
+         * with a 32bit long and (2^32 - 2) elements on targets with a 64bit long.
+         * On the latter, the tag that protects against the ABA problem only
+         * wraps after 2^32 allocations.
          */
         template<typename T>
         class TsPool
@@ -64,13 +69,15 @@ namespace RTT
         public:
             typedef T value_t;
         private:
+            typedef os::HalfWord Index;
+
             union Pointer_t
             {
-                unsigned int value;
+                unsigned long value;
                 struct _ptr_type
                 {
-                    unsigned short tag;
-                    unsigned short index;
+                    Index tag;
+                    Index index;
                 } ptr;
             };
 
@@ -95,6 +102,11 @@ namespace RTT
             Item head;
 
             unsigned int pool_size, pool_capacity;
+            /**
+             * The number of free elements, such that size()
+             * does not need to walk the free list.
+             */
+            os::AtomicInt free_count;
         public:
 
             typedef unsigned int size_type;
@@ -105,6 +117,7 @@ namespace RTT
             TsPool(unsigned int ssize, const T& sample = T()) :
                 pool_size(0), pool_capacity(ssize)
             {
+                assert( ssize < (Index) -1 && "TsPool: capacity too large for this target." );
                 pool = new Item[ssize];
                 data_sample( sample );
             }
@@ -116,7 +129,7 @@ namespace RTT
                 unsigned int i = 0, endseen = 0;
                 for (; i < pool_capacity; i++)
                 {
-                    if (pool[i].next.ptr.index == (unsigned short) -1)
+                    if (pool[i].next.ptr.index == (Index) -1)
                     {
                         ++endseen;
                     }
@@ -140,8 +153,9 @@ namespace RTT
                 {
                     pool[i].next.ptr.index = i + 1;
                 }
-                pool[pool_capacity - 1].next.ptr.index = (unsigned short) -1;
+                pool[pool_capacity - 1].next.ptr.index = (Index) -1;
                 head.next.ptr.index = 0;
+                free_count.set( pool_capacity );
             }
 
             /**
@@ -165,7 +179,7 @@ namespace RTT
                 {
                     oldval.value = head.next.value;
                     //List empty?
-                    if (oldval.ptr.index == (unsigned short) -1)
+                    if (oldval.ptr.index == (Index) -1)
                     {
                         return 0;
                     }
@@ -173,6 +187,7 @@ namespace RTT
                     newval.ptr.index = item->next.ptr.index;
                     newval.ptr.tag = oldval.ptr.tag + 1;
                 } while (!os::CAS(&head.next.value, oldval.value, newval.value));
+                free_count.dec();
                 return &item->value;
             }
 
@@ -193,26 +208,19 @@ namespace RTT
                     head_next.ptr.index = (item - pool);
                     head_next.ptr.tag = oldval.ptr.tag + 1;
                 } while (!os::CAS(&head.next.value, oldval.value, head_next.value));
+                free_count.inc();
                 return true;
             }
 
             /**
              * Return the number of elements that are available to be allocated.
-             * This function is not thread-safe and should not be used when concurrent
-             * allocate()/deallocate() functions are running.
+             * This is a constant time operation. When allocate()/deallocate()
+             * functions are running concurrently, the result may be outdated.
              * @return the number of elements left to allocate.
              */
             unsigned int size()
             {
-                unsigned int ret = 0;
-                volatile Item* oldval;
-                oldval = &head;
-                while ( oldval->next.ptr.index != (unsigned short) -1) {
-                    ++ret;
-                    oldval = &pool[oldval->next.ptr.index];
-                    assert(ret <= pool_capacity); // abort on corruption due to concurrency.
-                }
-                return ret;
+                return free_count.read();
             }
 
             /**
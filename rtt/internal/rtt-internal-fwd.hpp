@@ -93,6 +93,8 @@ namespace RTT {
         template<class T>
         class Queue;
         template<class T>
+        class ResizableMWSRQueue;
+        template<class T>
         struct AStore;
         template<class T>
         struct DSRStore;
@@ -137,6 +139,8 @@ namespace RTT {
         template<typename T>
         class ChannelDataElement;
         template<typename T>
+        class ChannelSharedDataElement;
+        template<typename T>
         class ConnInputEndpoint;
         template<typename T>
         class ConnOutputEndpoint;
@@ -159,6 +163,8 @@ namespace RTT {
         template<typename T>
         class ReferenceDataSource;
         template<typename T>
+        class SharedDataStorage;
+        template<typename T>
         class TsPool;
         template<typename T>
         class ValueDataSource;
@@ -55,6 +55,22 @@ namespace RTT
         return expected == oro_cmpxchg(addr, expected, value);
     }
 
+    template<int LongSize>
+    struct HalfWordHelper { typedef unsigned short type; };
+
+    template<>
+    struct HalfWordHelper<8> { typedef unsigned int type; };
+
+    /**
+     * An unsigned integer of half the size of an unsigned long, which
+     * is the largest type CAS() supports on all targets. Lock-free
+     * containers pack two indexes of this type in one unsigned long,
+     * such that both can be swapped at once. This is an unsigned short
+     * on targets with a 32bit long and an unsigned int on targets with
+     * a 64bit long.
+     */
+    typedef HalfWordHelper<sizeof(unsigned long)>::type HalfWord;
+
 }}
 
 #endif
@@ -41,8 +41,10 @@
 #include "threads.hpp"
 #include "../Logger.hpp"
 #include "MutexLock.hpp"
+#include "../base/DataObjectSeqLock.hpp"
 
 #include "../rtt-config.h"
+#include <cstring>
 
 #ifdef OROPKG_OS_THREAD_SCOPE
 # include "../extras/dev/DigitalOutInterface.hpp"
@@ -127,8 +129,12 @@ namespace RTT {
                             if (task->period != 0) // periodic
                             {
                                 MutexLock lock(task->breaker);
+                                // how late this cycle started compared to the period
+                                // timeline, the first cycle starts at start().
+                                NANO_TIME latency = 0;
                                 while(task->running && !task->prepareForExit )
                                 {
+                                    NANO_TIME step_start = rtos_get_time_ns();
                                     try
                                     {
                                         SCOPE_ON
@@ -140,6 +146,7 @@ namespace RTT {
                                         SCOPE_OFF
                                         throw;
                                     }
+                                    NANO_TIME step_end = rtos_get_time_ns();
 
                                     // Check changes in period
                                     if ( cur_period != task->period) {
@@ -148,6 +155,8 @@ namespace RTT {
                                         cur_period = task->period;
                                         if (cur_period == 0)
                                             break; // break while(task->running) if no longer periodic
+                                        if (task->mreservation != 0)
+                                            task->applyReservation();
                                     }
 
                                     // Check changes in scheduler
@@ -158,7 +167,10 @@ namespace RTT {
                                     // rtos_task_wait_period will return immediately if
                                     // the task is not periodic (ie period == 0)
                                     // return non-zero to indicate overrun.
-                                    if (rtos_task_wait_period(task->getTask()) != 0)
+                                    bool missed = rtos_task_wait_period(task->getTask()) != 0;
+                                    task->recordCycle(latency, step_end - step_start, missed);
+                                    latency = rtos_task_get_wakeup_latency(task->getTask());
+                                    if (missed)
                                     {
                                         ++overruns;
                                         if (overruns == task->maxOverRun)
@@ -240,11 +252,14 @@ namespace RTT {
                     msched_type(scheduler), active(false), prepareForExit(false),
                     inloop(false),running(false),
                     maxOverRun(OROSEM_OS_PERIODIC_THREADS_MAX_OVERRUN),
-                    period(Seconds_to_nsecs(periods)) // Do not call setPeriod(), since the semaphores are not yet used !
+                    period(Seconds_to_nsecs(periods)), // Do not call setPeriod(), since the semaphores are not yet used !
+                    mstats( new base::DataObjectSeqLock<ThreadStats>() ), mstats_reset(false),
+                    mreservation(0), mreservation_deadline(0)
 #ifdef OROPKG_OS_THREAD_SCOPE
         ,d(NULL)
 #endif
         {
+            std::memset(&mstats_work, 0, sizeof(mstats_work));
             this->setup(_priority, cpu_affinity, name);
         }
 
@@ -333,6 +348,7 @@ namespace RTT {
             terminate();
             log(Debug) << " done" << endlog();
             rtos_sem_destroy(&sem);
+            delete mstats;
 
         }
 
@@ -466,6 +482,8 @@ namespace RTT {
             log(Info) << "Setting scheduler type for Thread '"
                       << rtos_task_get_name(&rtos_task) << "' to "
                       << sched_type << endlog();
+            // a scheduler change replaces any reservation.
+            mreservation = 0;
             rtos_task_set_scheduler(&rtos_task, sched_type); // this may be a no-op, in that case, configure() will pick the change up.
             msched_type = sched_type;
             rtos_sem_signal(&sem);
@@ -488,8 +506,12 @@ namespace RTT {
             // reconfigure period
             rtos_task_set_period(&rtos_task, period);
 
-            // reconfigure scheduler.
-            if (msched_type != rtos_task_get_scheduler(&rtos_task))
+            // reconfigure scheduler, unless the thread runs on a reservation.
+            if (mreservation != 0)
+            {
+                applyReservation();
+            }
+            else if (msched_type != rtos_task_get_scheduler(&rtos_task))
             {
                 rtos_task_set_scheduler(&rtos_task, msched_type);
                 msched_type = rtos_task_get_scheduler(&rtos_task);
@@ -635,6 +657,85 @@ namespace RTT {
         {
             rtos_task_set_wait_period_policy(&rtos_task, p);  
         }
+
+        bool Thread::setReservation(Seconds runtime, Seconds deadline)
+        {
+            Logger::In in("Thread::setReservation");
+            if (runtime < 0 || deadline < 0)
+                return false;
+            NANO_TIME old_runtime = mreservation, old_deadline = mreservation_deadline;
+            mreservation = Seconds_to_nsecs(runtime);
+            mreservation_deadline = Seconds_to_nsecs(deadline);
+            if (mreservation == 0)
+            {
+                // back to the scheduler and priority of this thread.
+                if (old_runtime != 0)
+                    rtos_task_set_scheduler(&rtos_task, msched_type);
+                return true;
+            }
+            if ( applyReservation() )
+            {
+                log(Info) << "Reserved " << mreservation << "ns of runtime for Thread '"
+                          << rtos_task_get_name(&rtos_task) << "'." << endlog();
+                return true;
+            }
+            // the previous reservation, if any, is still in effect.
+            mreservation = old_runtime;
+            mreservation_deadline = old_deadline;
+            return false;
+        }
+
+        Seconds Thread::getReservation() const
+        {
+            return nsecs_to_Seconds(mreservation);
+        }
+
+        bool Thread::applyReservation()
+        {
+            NANO_TIME resv_period = period != 0 ? period : mreservation_deadline;
+            NANO_TIME deadline = mreservation_deadline != 0 ? mreservation_deadline : resv_period;
+            return rtos_task_set_reservation(&rtos_task, mreservation, deadline, resv_period) == 0;
+        }
+
+        void Thread::recordCycle(NANO_TIME latency, NANO_TIME exec_time, bool missed)
+        {
+            ThreadStats& st = mstats_work;
+            if (mstats_reset) {
+                mstats_reset = false;
+                std::memset(&st, 0, sizeof(st));
+            }
+            ++st.cycles;
+            st.last_latency = latency;
+            st.total_latency += latency;
+            if (latency > st.max_latency)
+                st.max_latency = latency;
+            st.last_exec_time = exec_time;
+            st.total_exec_time += exec_time;
+            if (exec_time > st.max_exec_time)
+                st.max_exec_time = exec_time;
+            NANO_TIME bucket = period ? exec_time * 10 / period : ThreadStats::HistogramSize - 1;
+            ++st.exec_histogram[ bucket < ThreadStats::HistogramSize - 1 ? bucket : ThreadStats::HistogramSize - 1 ];
+
+            if (missed) {
+                ++st.missed_deadlines;
+                if (++st.consecutive_misses > st.max_consecutive_misses)
+                    st.max_consecutive_misses = st.consecutive_misses;
+            } else
+                st.consecutive_misses = 0;
+
+            mstats->Set(st);
+        }
+
+        bool Thread::getTimingStats(ThreadStats& stats) const
+        {
+            mstats->Get(stats);
+            return true;
+        }
+
+        void Thread::resetTimingStats()
+        {
+            mstats_reset = true;
+        }
     }
 }
 
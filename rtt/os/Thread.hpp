@@ -44,6 +44,7 @@
 
 #include "ThreadInterface.hpp"
 #include "Mutex.hpp"
+#include "../base/rtt-base-fwd.hpp"
 
 #include <string>
 
@@ -210,6 +211,32 @@ namespace RTT
 
             virtual void setWaitPeriodPolicy(int p);
 
+            /**
+             * Reserve CPU time for this thread: \a runtime seconds in each
+             * period, to be consumed within \a deadline seconds after the
+             * start of the period. On Linux this puts the thread in
+             * SCHED_DEADLINE, such that the kernel enforces the budget and
+             * refuses reservations which do not fit on the CPUs.
+             * The reservation follows later changes of the period.
+             * @param runtime The budget per period. Zero drops the reservation
+             * and restores the scheduler and priority of this thread.
+             * @param deadline The relative deadline, zero means the period.
+             * A non periodic thread must specify a deadline, which is then
+             * also used as the reservation period.
+             * @return true if the reservation was accepted.
+             */
+            bool setReservation(Seconds runtime, Seconds deadline = 0);
+
+            /**
+             * @return the runtime reserved by setReservation(), or zero
+             * if this thread has no reservation.
+             */
+            Seconds getReservation() const;
+
+            virtual bool getTimingStats(ThreadStats& stats) const;
+
+            virtual void resetTimingStats();
+
         protected:
             /**
              * Exit and destroy the thread
@@ -254,6 +281,17 @@ namespace RTT
              */
             void configure();
 
+            /**
+             * Adds one periodic cycle to the timing statistics and
+             * publishes them. Only called by the thread itself.
+             */
+            void recordCycle(NANO_TIME latency, NANO_TIME exec_time, bool missed);
+
+            /**
+             * Passes the current reservation and period to the RTOS.
+             */
+            bool applyReservation();
+
             static unsigned int default_stack_size;
 
             /**
@@ -308,6 +346,25 @@ namespace RTT
              */
             NANO_TIME period;
 
+            /**
+             * The timing statistics as accumulated by the thread, and
+             * the copy which is published for other threads to read.
+             */
+            ThreadStats mstats_work;
+            base::DataObjectSeqLock<ThreadStats>* mstats;
+
+            /**
+             * Set by resetTimingStats(), cleared by the thread.
+             */
+            volatile bool mstats_reset;
+
+            /**
+             * The reserved runtime and relative deadline as given to
+             * setReservation(), or zero.
+             */
+            NANO_TIME mreservation;
+            NANO_TIME mreservation_deadline;
+
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Pointer to Threadscope device
             dev::DigitalOutInterface * d;
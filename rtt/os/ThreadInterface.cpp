@@ -59,3 +59,12 @@ bool ThreadInterface::isSelf() const
 {
     return rtos_task_is_self( this->getTask() ) == 1;
 }
+
+bool ThreadInterface::getTimingStats(ThreadStats& stats) const
+{
+    return false;
+}
+
+void ThreadInterface::resetTimingStats()
+{
+}
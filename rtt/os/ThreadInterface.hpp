@@ -42,6 +42,7 @@
 #include "fosi.h"
 #include "threads.hpp"
 #include "Time.hpp"
+#include "ThreadStats.hpp"
 #include "../rtt-config.h"
 
 namespace RTT
@@ -205,6 +206,21 @@ namespace RTT
              */
             virtual void yield() = 0;
 
+            /**
+             * Reads the timing statistics of this thread's periodic loop.
+             * This is lock-free and may be called from any thread, while the
+             * thread is running.
+             * @param stats Is filled in with the statistics.
+             * @return false if this thread does not record statistics.
+             */
+            virtual bool getTimingStats(ThreadStats& stats) const;
+
+            /**
+             * Clears the timing statistics. The thread applies this at
+             * the start of its next periodic cycle.
+             */
+            virtual void resetTimingStats();
+
             /**
              * The unique thread number (within the same process).
              */
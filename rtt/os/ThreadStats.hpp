@@ -0,0 +1,100 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  ThreadStats.hpp
+
+                        ThreadStats.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef ORO_OS_THREAD_STATS_HPP
+#define ORO_OS_THREAD_STATS_HPP
+
+#include "Time.hpp"
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * Timing statistics of a periodic thread, as recorded by
+     * its periodic loop. All times are in nanoseconds.
+     *
+     * A cycle misses its deadline when step() did not return
+     * before the start of the next period, which is also what
+     * Thread::setMaxOverrun() counts.
+     *
+     * @see ThreadInterface::getTimingStats()
+     */
+    struct ThreadStats
+    {
+        /**
+         * The number of buckets of exec_histogram.
+         */
+        enum { HistogramSize = 11 };
+
+        /**
+         * The number of periodic cycles executed.
+         */
+        unsigned long long cycles;
+        /**
+         * The total number of cycles that missed their deadline.
+         */
+        unsigned long long missed_deadlines;
+        /**
+         * The number of cycles in the current run of missed deadlines.
+         */
+        unsigned int consecutive_misses;
+        /**
+         * The longest run of consecutively missed deadlines.
+         */
+        unsigned int max_consecutive_misses;
+        /**
+         * Wake-up latency: the time between the scheduled and the
+         * actual start of a cycle, on the clock of the period timeline
+         * the thread sleeps on. Zero on targets which do not measure it.
+         */
+        nsecs last_latency, max_latency, total_latency;
+        /**
+         * The execution time of step().
+         */
+        nsecs last_exec_time, max_exec_time, total_exec_time;
+        /**
+         * exec_histogram[i] counts the cycles of which step() took
+         * between i and i+1 tenths of the period. The last bucket
+         * counts the cycles which took the full period or more.
+         */
+        unsigned int exec_histogram[HistogramSize];
+    };
+}}
+
+#endif
@@ -60,22 +60,16 @@ namespace RTT {
         // This code is executed from mThread's thread
         while (!mdo_quit) {
             Time wake_up_time;
-            TimerId next_timer_id = 0;
 
             // Select next timer.
             {// This scope is for MutexLock.
-                // find wake_up_time
-                // check timers queue.
                 MutexLock locker(m);
                 // We can't use infinite as the OS may internally use time_spec, which can not
                 // represent as much in the future (until 2038) // XXX Year-2038 Bug
-                wake_up_time = (TimeService::InfiniteNSecs/4)-1;
-                for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
-                    if ( it->first != 0 && it->first < wake_up_time  ) {
-                        wake_up_time = it->first;
-                        next_timer_id = it - mtimers.begin();
-                    }
-                }
+                if ( mheap.empty() )
+                    wake_up_time = (TimeService::InfiniteNSecs/4)-1;
+                else
+                    wake_up_time = mtimers[ mheap.front() ].first;
             }// MutexLock
 
             // Wait
@@ -87,17 +81,26 @@ namespace RTT {
 
             // Timeout handling
             if (ret == -1) {
-                // a timer expired
-                // First: reset/reprogram the timer that expired:
+                // First: collect and reset/reprogram all timers that expired:
                 {
                     MutexLock locker(m);
-                    // detect corner case for resize:
-                    if ( next_timer_id < int(mtimers.size()) ) {
-                        // now clear or reprogram it.
-                        TimerIds::iterator tim = mtimers.begin() + next_timer_id;
+                    Time now = mTimeserv->getNSecs();
+                    // pick up a larger buffer prepared by setMaxTimers().
+                    if ( mexpired_spare.capacity() > mexpired.capacity() )
+                        mexpired.swap( mexpired_spare );
+                    mexpired.clear();
+                    while ( !mheap.empty() && mtimers[ mheap.front() ].first <= now ) {
+                        mexpired.push_back( mheap.front() );
+                        heapRemove( mheap.front() );
+                    }
+                    // Periodic timers are reinserted afterwards, such that each
+                    // timer appears at most once in a batch.
+                    for (TimerIdList::iterator it = mexpired.begin(); it != mexpired.end(); ++it) {
+                        TimerIds::iterator tim = mtimers.begin() + *it;
                         if ( tim->second ) {
                             // periodic timer
                             tim->first += tim->second;
+                            heapUpdate( *it );
                         } else {
                             // aperiodic timer
                             tim->first = 0;
@@ -108,7 +111,8 @@ namespace RTT {
                 // to reprogram the timer.
                 // If we would first call timeout(), the code above would overwrite
                 // user settings.
-                timeout( next_timer_id );
+                if ( !mexpired.empty() )
+                    timeout( mexpired );
             }
         }
     }
@@ -125,6 +129,9 @@ namespace RTT {
     {
         mTimeserv = TimeService::Instance();
         mtimers.resize(max_timers);
+        mheap.reserve(max_timers);
+        mheap_pos.resize(max_timers, -1);
+        mexpired.reserve(max_timers);
         if (scheduler != -1) {
             mThread = new Activity(scheduler, priority, 0.0, this, "Timer");
             mThread->start();
@@ -142,15 +149,105 @@ namespace RTT {
         // User must implement this method.
     }
 
+    void Timer::timeout(const TimerIdList& timer_ids)
+    {
+        for (TimerIdList::const_iterator it = timer_ids.begin(); it != timer_ids.end(); ++it)
+            timeout( *it );
+    }
+
+    bool Timer::heapBefore(int a, int b) const
+    {
+        // Timers which expire at the same time are ordered by id.
+        const Time ta = mtimers[ mheap[a] ].first, tb = mtimers[ mheap[b] ].first;
+        return ta < tb || ( ta == tb && mheap[a] < mheap[b] );
+    }
+
+    void Timer::heapSwap(int a, int b)
+    {
+        std::swap( mheap[a], mheap[b] );
+        mheap_pos[ mheap[a] ] = a;
+        mheap_pos[ mheap[b] ] = b;
+    }
+
+    void Timer::heapUp(int pos)
+    {
+        while ( pos > 0 ) {
+            int parent = (pos - 1) / 2;
+            if ( !heapBefore( pos, parent ) )
+                return;
+            heapSwap( pos, parent );
+            pos = parent;
+        }
+    }
+
+    void Timer::heapDown(int pos)
+    {
+        int size = mheap.size();
+        while ( true ) {
+            int smallest = pos;
+            int child = 2 * pos + 1;
+            if ( child < size && heapBefore( child, smallest ) )
+                smallest = child;
+            ++child;
+            if ( child < size && heapBefore( child, smallest ) )
+                smallest = child;
+            if ( smallest == pos )
+                return;
+            heapSwap( pos, smallest );
+            pos = smallest;
+        }
+    }
+
+    void Timer::heapUpdate(TimerId timer_id)
+    {
+        int pos = mheap_pos[timer_id];
+        if ( pos == -1 ) {
+            // mheap has room for all timers, so this never allocates.
+            pos = mheap.size();
+            mheap.push_back( timer_id );
+            mheap_pos[timer_id] = pos;
+        }
+        heapUp( pos );
+        heapDown( mheap_pos[timer_id] );
+    }
+
+    void Timer::heapRemove(TimerId timer_id)
+    {
+        int pos = mheap_pos[timer_id];
+        if ( pos == -1 )
+            return;
+        int last = mheap.size() - 1;
+        if ( pos != last ) {
+            TimerId moved = mheap[last];
+            heapSwap( pos, last );
+            mheap.pop_back();
+            heapUp( pos );
+            heapDown( mheap_pos[moved] );
+        } else
+            mheap.pop_back();
+        mheap_pos[timer_id] = -1;
+    }
+
     void Timer::setMaxTimers(TimerId max)
     {
         MutexLock locker(m);
+        for (TimerId id = max; id < TimerId(mtimers.size()); ++id)
+            heapRemove( id );
         mtimers.resize(max, std::make_pair(Time(0), Time(0)) );
+        mheap_pos.resize(max, -1);
+        mheap.reserve(max);
+        // loop() may be iterating over mexpired, it swaps
+        // this one in the next time it collects timers.
+        if ( mexpired_spare.capacity() < TimerIdList::size_type(max) ) {
+            TimerIdList spare;
+            spare.reserve(max);
+            mexpired_spare.swap( spare );
+        }
     }
 
     bool Timer::startTimer(TimerId timer_id, double period)
     {
-        if ( timer_id < 0 || timer_id > int(mtimers.size()) || period < 0.0)
+        if ( timer_id < 0 || timer_id >= int(mtimers.size()) || period < 0.0)
         {
             log(Error) << "Invalid timer id or period" << endlog();
             return false;
@@ -162,6 +259,7 @@ namespace RTT {
             MutexLock locker(m);
             mtimers[timer_id].first = due_time;
             mtimers[timer_id].second = Seconds_to_nsecs( period );
+            heapUpdate( timer_id );
         }
         msem.signal();
         return true;
@@ -169,7 +267,7 @@ namespace RTT {
 
     bool Timer::arm(TimerId timer_id, double wait_time)
     {
-        if ( timer_id < 0 || timer_id > int(mtimers.size()) || wait_time < 0.0)
+        if ( timer_id < 0 || timer_id >= int(mtimers.size()) || wait_time < 0.0)
         {
             log(Error) << "Invalid timer id or wait time" << endlog();
             return false;
@@ -182,6 +280,7 @@ namespace RTT {
             MutexLock locker(m);
             mtimers[timer_id].first  = due_time;
             mtimers[timer_id].second = 0;
+            heapUpdate( timer_id );
         }
         msem.signal();
         return true;
@@ -190,7 +289,7 @@ namespace RTT {
     bool Timer::isArmed(TimerId timer_id) const
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return false;
@@ -201,7 +300,7 @@ namespace RTT {
     double Timer::timeRemaining(TimerId timer_id) const
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return 0.0;
@@ -217,11 +316,12 @@ namespace RTT {
     bool Timer::killTimer(TimerId timer_id)
     {
         MutexLock locker(m);
-        if (timer_id < 0 || timer_id > int(mtimers.size()) )
+        if (timer_id < 0 || timer_id >= int(mtimers.size()) )
         {
             log(Error) << "Invalid timer id" << endlog();
             return false;
         }
+        heapRemove( timer_id );
         mtimers[timer_id].first = 0;
         mtimers[timer_id].second = 0;
         return true;
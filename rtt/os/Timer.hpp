@@ -62,6 +62,12 @@ namespace RTT
      * If you do not attach an activity, the Timer will create a thread
      * of its own and start it. That thread will be stopped and cleaned up
      * when the Timer is destroyed.
+     *
+     * The armed timers are kept in a binary heap, ordered by expiry time,
+     * such that the Timer scales to thousands of timers: arming or killing
+     * a timer is O(log n) and finding the next expiry is O(1). No memory
+     * is allocated after construction or setMaxTimers(). Timers which expire
+     * together are dispatched in one batch, see timeout(const TimerIdList&).
      */
     class RTT_API Timer
         : public base::RunnableInterface
@@ -71,6 +77,10 @@ namespace RTT
          * A positive numeric ID representing a timer.
          */
         typedef int TimerId;
+        /**
+         * A list of timer ids which expired together.
+         */
+        typedef std::vector<TimerId> TimerIdList;
     protected:
         TimeService* mTimeserv;
         base::ActivityInterface* mThread;
@@ -84,8 +94,36 @@ namespace RTT
          */
         typedef std::vector<std::pair<Time, Time> > TimerIds;
         TimerIds mtimers;
+        /**
+         * The ids of the armed timers, as a binary heap on their
+         * expiry time.
+         */
+        std::vector<TimerId> mheap;
+        /**
+         * Index in mheap of each timer id, or -1 if not armed.
+         */
+        std::vector<int> mheap_pos;
+        /**
+         * The batch of expired timers, only used by loop().
+         */
+        TimerIdList mexpired;
+        /**
+         * A larger buffer for mexpired, reserved by setMaxTimers()
+         * such that loop() never allocates. Guarded by \a m.
+         */
+        TimerIdList mexpired_spare;
         bool mdo_quit;
 
+        /**
+         * Heap maintenance, call with \a m locked.
+         */
+        bool heapBefore(int a, int b) const;
+        void heapSwap(int a, int b);
+        void heapUp(int pos);
+        void heapDown(int pos);
+        void heapUpdate(TimerId timer_id);
+        void heapRemove(TimerId timer_id);
+
         bool initialize();
         void finalize();
         void step();
@@ -119,6 +157,15 @@ namespace RTT
          */
         virtual void timeout(TimerId timer_id);
 
+        /**
+         * This function is called with all the timers that expired
+         * at the same time, in order of their expiry time. The default
+         * implementation calls timeout(TimerId) for each of them, override
+         * it to handle many simultaneous timeouts at once.
+         * @param timer_ids The numbers of the timers that expired.
+         */
+        virtual void timeout(const TimerIdList& timer_ids);
+
         /**
          * Change the maximum number of timers in this object.
          * Any added timer with id >= \a max will be removed.
@@ -174,6 +174,12 @@ namespace RTT
       return 0;
     }
 
+    INTERNAL_QUAL NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task )
+    {
+      // the timeline is kept by the wake-up alarm
+      return 0;
+    }
+
     INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
       // Free name
       free(mytask->name);
@@ -216,6 +222,11 @@ namespace RTT
     return ~0;
     }
 
+    INTERNAL_QUAL int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period)
+    {
+        return -1;
+    }
+
 	INTERNAL_QUAL unsigned int rtos_task_get_pid(const RTOS_TASK* task)
 	{
 		return 0;
@@ -179,6 +179,15 @@ namespace RTT {
              */
             int rtos_task_wait_period( RTOS_TASK* task );
 
+            /**
+             * Returns how late the last rtos_task_wait_period() of \a task
+             * returned, compared to the wake-up time it was scheduled for,
+             * measured on the clock of the period timeline.
+             * @return the latency in nanoseconds, or zero if the target
+             * does not measure it.
+             */
+            NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task );
+
             /**
              * This function must join the thread created with
              * rtos_task_create and then clean up the RTOS_TASK struct.
@@ -241,6 +250,22 @@ namespace RTT {
              */
             unsigned rtos_task_get_cpu_affinity(const RTOS_TASK * task);
 
+            /**
+             * Give a thread a CPU reservation: each \a period, it is
+             * guaranteed \a runtime of CPU time, to be consumed before
+             * \a deadline. On Linux this maps to SCHED_DEADLINE and the
+             * kernel's admission control may refuse the reservation.
+             * A successful call replaces the scheduler and priority of
+             * the thread; use rtos_task_set_scheduler() to drop it again.
+             * @param task The thread to reserve CPU time for.
+             * @param runtime The budget per period, in nanoseconds.
+             * @param deadline The relative deadline, runtime <= deadline <= period.
+             * @param period The reservation period, in nanoseconds.
+             * @return 0 if the reservation was accepted, -1 if it was refused
+             * or if the RTOS does not support reservations.
+             */
+            int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period);
+
             /**
              * Returns the name by which a task is known in the RTOS.
              * @param task The task to query.
@@ -74,6 +74,7 @@ extern "C"
 
     TIME_SPEC periodMark;
     NANO_TIME period;
+    NANO_TIME wakeLatency;
 
     char* name;
 
@@ -50,6 +50,13 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <sys/syscall.h>
+#include <stdint.h>
+#include <cerrno>
+#include <cstring>
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
 
 using namespace std;
 
@@ -62,6 +69,7 @@ namespace RTT
 	{
         const char* name = "main";
         main_task->wait_policy = ORO_WAIT_ABS;
+        main_task->wakeLatency = 0;
 	    main_task->name = strcpy( (char*)malloc( (strlen(name) + 1) * sizeof(char)), name);
         main_task->thread = pthread_self();
 	    pthread_attr_init( &(main_task->attr) );
@@ -113,10 +121,13 @@ namespace RTT
 	{
         int rv; // return value
         task->wait_policy = ORO_WAIT_ABS;
+        task->wakeLatency = 0;
         rtos_task_check_priority( &sched_type, &priority );
         // Save priority internally, since the pthread_attr* calls are broken !
         // we will pick it up later in rtos_task_set_scheduler().
         task->priority = priority;
+        // set by the thread itself in rtos_posix_thread_wrapper().
+        task->pid = 0;
 
         PosixCookie* xcookie = (PosixCookie*)malloc( sizeof(PosixCookie) );
         xcookie->data = obj;
@@ -214,18 +225,33 @@ namespace RTT
     INTERNAL_QUAL int rtos_task_get_scheduler(const RTOS_TASK* task) {
         int policy = -1;
         struct sched_param param;
+        // the C library caches the policy it set itself, so ask the kernel
+        // once we know the thread, to see a SCHED_DEADLINE reservation too.
+        if ( task && task->pid != 0 && (policy = sched_getscheduler(task->pid)) != -1 )
+            return policy;
         // first retrieve thread scheduling parameters:
         if ( task && task->thread != 0 && pthread_getschedparam(task->thread, &policy, &param) == 0)
             return policy;
         return -1;
     }
 
+    /**
+     * The periodic timeline is kept against CLOCK_MONOTONIC, such that
+     * setting the system time does not shift or stall periodic threads.
+     */
+    static inline NANO_TIME rtos_get_period_time_ns()
+    {
+        TIME_SPEC tv;
+        clock_gettime(CLOCK_MONOTONIC, &tv);
+        return NANO_TIME( tv.tv_sec ) * 1000000000LL + NANO_TIME( tv.tv_nsec );
+    }
+
 	INTERNAL_QUAL void rtos_task_make_periodic(RTOS_TASK* mytask, NANO_TIME nanosecs )
 	{
 	    // set period
 	    mytask->period = nanosecs;
 	    // set next wake-up time.
-	    mytask->periodMark = ticks2timespec( nano2ticks( rtos_get_time_ns() + nanosecs ) );
+	    mytask->periodMark = ticks2timespec( nano2ticks( rtos_get_period_time_ns() + nanosecs ) );
 	}
 
 	INTERNAL_QUAL void rtos_task_set_period( RTOS_TASK* mytask, NANO_TIME nanosecs )
@@ -244,13 +270,16 @@ namespace RTT
             return 0;
 
         // record this to detect overrun.
-	    NANO_TIME now = rtos_get_time_ns();
+	    NANO_TIME now = rtos_get_period_time_ns();
 	    NANO_TIME wake= task->periodMark.tv_sec * 1000000000LL + task->periodMark.tv_nsec;
 
         // inspired by nanosleep man page for this construct:
-        while ( clock_nanosleep(CLOCK_REALTIME, TIMER_ABSTIME, &(task->periodMark), NULL) != 0 && errno == EINTR ) {
+        // clock_nanosleep returns the error number instead of setting errno.
+        while ( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &(task->periodMark), NULL) == EINTR ) {
             errno = 0;
         }
+        NANO_TIME woke = rtos_get_period_time_ns();
+        task->wakeLatency = woke > wake ? woke - wake : 0;
 
         if (task->wait_policy == ORO_WAIT_ABS)
         {
@@ -265,7 +294,7 @@ namespace RTT
         else
         {
           TIME_SPEC ts = ticks2timespec( nano2ticks( task->period) );
-          TIME_SPEC now = ticks2timespec( rtos_get_time_ns() );
+          TIME_SPEC now = ticks2timespec( rtos_get_period_time_ns() );
           NANO_TIME tn = (now.tv_nsec + ts.tv_nsec);
           task->periodMark.tv_nsec = tn % 1000000000LL;
           task->periodMark.tv_sec = ts.tv_sec + now.tv_sec + tn / 1000000000LL;
@@ -274,6 +303,11 @@ namespace RTT
 	    return now > wake ? -1 : 0;
 	}
 
+	INTERNAL_QUAL NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task )
+	{
+	    return task->wakeLatency;
+	}
+
 	INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
         pthread_join( mytask->thread, 0);
         pthread_attr_destroy( &(mytask->attr) );
@@ -429,6 +463,51 @@ namespace RTT
         return ~0;
         }
 
+#ifdef SYS_sched_setattr
+    /**
+     * The layout of the kernel's struct sched_attr (first version),
+     * which older C libraries do not provide.
+     */
+    struct rtos_sched_attr {
+        uint32_t size;
+        uint32_t sched_policy;
+        uint64_t sched_flags;
+        int32_t  sched_nice;
+        uint32_t sched_priority;
+        uint64_t sched_runtime;
+        uint64_t sched_deadline;
+        uint64_t sched_period;
+    };
+#endif
+
+    INTERNAL_QUAL int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period)
+    {
+#ifdef SYS_sched_setattr
+        // the pid is only known once the thread itself has started.
+        if ( task == 0 || task->pid == 0 )
+            return -1;
+        if ( runtime <= 0 || deadline < runtime || period < deadline )
+            return -1;
+        struct rtos_sched_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.sched_policy = SCHED_DEADLINE;
+        attr.sched_runtime = runtime;
+        attr.sched_deadline = deadline;
+        attr.sched_period = period;
+        if ( syscall(SYS_sched_setattr, task->pid, &attr, 0) != 0 ) {
+            // EBUSY: admission control refused, EPERM: no CAP_SYS_NICE or
+            // a cpu affinity narrower than the root domain.
+            log(Warning) << "Could not set SCHED_DEADLINE reservation for thread '" << task->name << "': "
+                         << strerror(errno) << endlog();
+            return -1;
+        }
+        return 0;
+#else
+        return -1;
+#endif
+    }
+
 	INTERNAL_QUAL const char * rtos_task_get_name(const RTOS_TASK* task)
 	{
 	    return task->name;
@@ -335,6 +335,12 @@ namespace RTT
             return 0;
         }
 
+        INTERNAL_QUAL NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task )
+        {
+            // the timeline is kept by rt_task_wait_period()
+            return 0;
+        }
+
         INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
             if ( pthread_join((mytask->thread),0) != 0 )
                 Logger::log() << Logger::Critical << "Failed to join "<< mytask->name <<"."<< Logger::endl;
@@ -399,6 +405,11 @@ namespace RTT
 	{
         return ~0;
         }
+
+	INTERNAL_QUAL int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period)
+	{
+	    return -1;
+	}
     }
 }
 #undef INTERNAL_QUAL
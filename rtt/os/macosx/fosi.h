@@ -58,6 +58,7 @@ extern "C"
 
         NANO_TIME periodMark;
         NANO_TIME period;
+        NANO_TIME wakeLatency;
 
         char* name;
 
@@ -56,6 +56,7 @@ namespace RTT
 	    pthread_attr_setschedparam(&(main_task->attr), &sp);
         main_task->priority = sp.sched_priority;
         main_task->wait_policy = ORO_WAIT_ABS;
+        main_task->wakeLatency = 0;
 	    return 0;
 	}
 
@@ -81,6 +82,7 @@ namespace RTT
             // we will pick it up later in rtos_task_set_scheduler().
             task->priority = priority;
             task->wait_policy = ORO_WAIT_ABS;
+            task->wakeLatency = 0;
 
 	    // Set name
 	    if ( strlen(name) == 0 )
@@ -177,7 +179,8 @@ namespace RTT
 
 	    //rtos_printf("Time is %lld nsec, Mark is %lld nsec.\n",rtos_get_time_ns(), task->periodMark );
 	    // CALCULATE in nsecs
-	    NANO_TIME timeRemaining = task->periodMark - rtos_get_time_ns();
+	    NANO_TIME wake = task->periodMark;
+	    NANO_TIME timeRemaining = wake - rtos_get_time_ns();
 
         // next wake-up time :
       if (task->wait_policy == ORO_WAIT_ABS)
@@ -193,10 +196,16 @@ namespace RTT
 	        //rtos_printf("Waiting for %lld nsec\n",timeRemaining);
 	        TIME_SPEC ts( ticks2timespec( timeRemaining ) );
 	        rtos_nanosleep( &ts , NULL );
-	        return 0;
 	    }
+	    NANO_TIME woke = rtos_get_time_ns();
+	    task->wakeLatency = woke > wake ? woke - wake : 0;
 
-	    return -1;
+	    return timeRemaining > 0 ? 0 : -1;
+	}
+
+	INTERNAL_QUAL NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task )
+	{
+	    return task->wakeLatency;
 	}
 
 	INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask)
@@ -279,6 +288,11 @@ namespace RTT
         return ~0;
         }
 
+	INTERNAL_QUAL int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period)
+	{
+	    return -1;
+	}
+
 	INTERNAL_QUAL const char * rtos_task_get_name(const RTOS_TASK* task)
 	{
 	    return task->name;
@@ -94,5 +94,12 @@ int oro_atomic_inc_and_test(oro_atomic_t *a);
  */
 int oro_cmpxchg(void volatile* ptr, unsigned long o, unsigned long n);
 
+/**
+ * Full memory barrier. All loads and stores issued before
+ * the barrier are completed before any load or store issued
+ * after it, both for the compiler and for the processor.
+ */
+void oro_mb(void);
+
 
 #endif // __ORO_ARCH_INTERFACE__
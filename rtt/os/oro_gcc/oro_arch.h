@@ -80,5 +80,13 @@ static __inline__ int oro_atomic_inc_and_test(oro_atomic_t *a_int)
 #define oro_cmpxchg(ptr,o,n)\
     ((__typeof__(*(ptr)))__sync_val_compare_and_swap((ptr),(o),(n)))
 
+/**
+ * Full memory barrier.
+ */
+static __inline__ void oro_mb(void)
+{
+    __sync_synchronize();
+}
+
 
 #endif // __GCC_ORO_ARCH__
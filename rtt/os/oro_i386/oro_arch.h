@@ -155,6 +155,12 @@ static inline unsigned long __oro_cmpxchg(volatile void *ptr, unsigned long old,
     ((__typeof__(*(ptr)))__oro_cmpxchg((ptr),(unsigned long)(o),\
                     (unsigned long)(n),sizeof(*(ptr))))
 
+/* not all i386 processors have mfence, a locked instruction is a full barrier too. */
+static __inline__ void oro_mb(void)
+{
+	__asm__ __volatile__(ORO_LOCK "addl $0,0(%%esp)" : : : "memory");
+}
+
 #undef ORO_LOCK
 #undef ORO_LOCK_PREFIX
 #endif
@@ -103,4 +103,6 @@ template<typename T> inline T oro_cmpxchg(volatile void * ptr, T old, T _new)
 
 #pragma warning(pop)
 
+#define oro_mb()	MemoryBarrier()
+
 #endif
@@ -116,4 +116,10 @@ static __inline__ int oro_atomic_inc_and_test(oro_atomic_t *a_int)
   return ret;
 }
 
+/*
+ * There is no portable barrier without assembler. The lock-free
+ * algorithms that need one are not used on this target.
+ */
+#define oro_mb()
+
 #endif
@@ -72,6 +72,11 @@ static inline void isync(void)
 	__asm__ __volatile__ ("isync" : : : "memory");
 }
 
+static inline void oro_mb(void)
+{
+	__asm__ __volatile__ ("sync" : : : "memory");
+}
+
 // ==================================================
 // asm/asm-compat.h
 
@@ -179,6 +179,11 @@ static inline unsigned long __oro_cmpxchg(volatile void *ptr, unsigned long old,
     ((__typeof__(*(ptr)))__oro_cmpxchg((ptr),(unsigned long)(o),\
                     (unsigned long)(n),sizeof(*(ptr))))
 
+static __inline__ void oro_mb(void)
+{
+	__asm__ __volatile__("mfence" : : : "memory");
+}
+
 #undef ORO_LOCK_PREFIX
 #undef ORO_LOCK
 #endif
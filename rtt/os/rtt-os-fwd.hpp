@@ -20,6 +20,7 @@ namespace RTT {
         class Timer;
         struct CleanupFunction;
         struct InitFunction;
+        struct ThreadStats;
     }
     namespace detail {
         using namespace os;
@@ -89,6 +89,7 @@ extern "C"
 
       NANO_TIME periodMark;
       NANO_TIME period;
+      NANO_TIME wakeLatency;
 
       int sched_type; // currently not used
       int wait_policy;
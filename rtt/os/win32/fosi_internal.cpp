@@ -112,6 +112,7 @@ void ErrorHandler(LPTSTR lpszFunction)
 	{
         const char* name = "main";
         main_task->wait_policy = ORO_WAIT_ABS;
+        main_task->wakeLatency = 0;
 	    main_task->name = strcpy( (char*)malloc( (strlen(name) + 1) * sizeof(char)), name);
         main_task->threadId = GetCurrentThreadId();
         main_task->handle = 0;
@@ -147,6 +148,7 @@ void ErrorHandler(LPTSTR lpszFunction)
         // TODO implement scheduler by using CreateProcess
         // Set name
         task->wait_policy = ORO_WAIT_ABS;
+        task->wakeLatency = 0;
         if (name == 0 || strlen(name) == 0)
             name = "Thread";
         task->name = strncpy((char*) malloc((strlen(name) + 1)
@@ -248,6 +250,8 @@ void ErrorHandler(LPTSTR lpszFunction)
  		TIME_SPEC ts( ticks2timespec( timeRemaining ) );
 		rtos_nanosleep( &ts , NULL );
       }
+      NANO_TIME woke = rtos_get_time_ns();
+      task->wakeLatency = woke > task->periodMark ? woke - task->periodMark : 0;
       //             else
       //                 rtos_printf( "GNULinux task did not get deadline !\n" );
 
@@ -260,6 +264,11 @@ void ErrorHandler(LPTSTR lpszFunction)
       return 0;
     }
 
+    INTERNAL_QUAL NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task )
+    {
+      return task->wakeLatency;
+    }
+
     INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
       // printf("T:%u -> ", (unsigned int) mytask);
       //printf(" rtos_task_delete ");
@@ -340,6 +349,11 @@ void ErrorHandler(LPTSTR lpszFunction)
     return ~0;
     }
 
+    INTERNAL_QUAL int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period)
+    {
+        return -1;
+    }
+
     INTERNAL_QUAL const char * rtos_task_get_name(const RTOS_TASK* t)
     {
     	/* printf("Get Name: ");
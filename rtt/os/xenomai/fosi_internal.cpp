@@ -426,6 +426,11 @@ namespace RTT
             return 0;
         }
 
+        INTERNAL_QUAL int rtos_task_set_reservation(RTOS_TASK * task, NANO_TIME runtime, NANO_TIME deadline, NANO_TIME period)
+        {
+            return -1;
+        }
+
         INTERNAL_QUAL const char* rtos_task_get_name(const RTOS_TASK* mytask) {
             return mytask->name;
         }
@@ -445,6 +450,12 @@ namespace RTT
             return -1;
         }
 
+        INTERNAL_QUAL NANO_TIME rtos_task_get_wakeup_latency( const RTOS_TASK* task )
+        {
+            // the timeline is kept by rt_task_wait_period()
+            return 0;
+        }
+
         INTERNAL_QUAL void rtos_task_delete(RTOS_TASK* mytask) {
             if ( rt_task_join(&(mytask->xenotask)) != 0 ) {
                 log(Error) << "Failed to join with thread " << mytask->name << endlog();
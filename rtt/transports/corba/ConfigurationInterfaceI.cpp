@@ -320,4 +320,28 @@ CORBA::Boolean RTT_corba_CConfigurationInterface_i::propertyFromString (
     return true;
 }
 
-
+::RTT::corba::CConfigurationInterface::CValues * RTT_corba_CConfigurationInterface_i::getValues (
+    const ::RTT::corba::CConfigurationInterface::CValueNames & properties,
+    const ::RTT::corba::CConfigurationInterface::CValueNames & attributes)
+{
+    ::RTT::corba::CConfigurationInterface::CValues_var ret = new ::RTT::corba::CConfigurationInterface::CValues();
+    ret->length( properties.length() + attributes.length() );
+    CORBA::ULong index = 0;
+    for (CORBA::ULong i = 0; i != properties.length(); ++i, ++index) {
+        DataSourceBase::shared_ptr ds = getPropertyDataSource( string(properties[i].in()) );
+        if ( !ds )
+            continue;
+        CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ds->getTypeInfo()->getProtocol(ORO_CORBA_PROTOCOL_ID) );
+        if ( ctt )
+            ctt->updateAny( ds, ret[index] );
+    }
+    for (CORBA::ULong i = 0; i != attributes.length(); ++i, ++index) {
+        DataSourceBase::shared_ptr ds = getAttributeDataSource( string(attributes[i].in()) );
+        if ( !ds )
+            continue;
+        CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ds->getTypeInfo()->getProtocol(ORO_CORBA_PROTOCOL_ID) );
+        if ( ctt )
+            ctt->updateAny( ds, ret[index] );
+    }
+    return ret._retn();
+}
@@ -170,6 +170,11 @@ class  RTT_corba_CConfigurationInterface_i
   CORBA::Boolean propertyFromString (
       const char* name, const char* value
     );
+
+  virtual
+  ::RTT::corba::CConfigurationInterface::CValues * getValues (
+      const ::RTT::corba::CConfigurationInterface::CValueNames & properties,
+      const ::RTT::corba::CConfigurationInterface::CValueNames & attributes);
 };
 
 
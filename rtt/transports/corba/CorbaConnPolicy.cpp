@@ -44,18 +44,59 @@
  */
 
 #include "CorbaConnPolicy.hpp"
+#include "../../Logger.hpp"
+
+using namespace RTT;
+
+static corba::CLockPolicy lockPolicyToCORBA(int lock_policy)
+{
+    switch (lock_policy)
+    {
+    case ConnPolicy::UNSYNC:
+        return corba::CUnsync;
+    case ConnPolicy::LOCKED:
+        return corba::CLocked;
+    case ConnPolicy::SPSC:
+        return corba::CSPSC;
+    case ConnPolicy::SEQLOCK:
+        return corba::CSeqLock;
+    case ConnPolicy::LOCK_FREE:
+        return corba::CLockFree;
+    default:
+        log(Warning) << "Unknown lock policy " << lock_policy << ", using LOCK_FREE for the remote connection." << endlog();
+        return corba::CLockFree;
+    }
+}
+
+static int lockPolicyToRTT(corba::CLockPolicy lock_policy)
+{
+    switch (lock_policy)
+    {
+    case corba::CUnsync:
+        return ConnPolicy::UNSYNC;
+    case corba::CLocked:
+        return ConnPolicy::LOCKED;
+    case corba::CSPSC:
+        return ConnPolicy::SPSC;
+    case corba::CSeqLock:
+        return ConnPolicy::SEQLOCK;
+    default:
+        return ConnPolicy::LOCK_FREE;
+    }
+}
 
 RTT::corba::CConnPolicy toCORBA(RTT::ConnPolicy const& policy)
 {
     RTT::corba::CConnPolicy corba_policy;
     corba_policy.type        = RTT::corba::CConnectionModel(policy.type);
     corba_policy.init        = policy.init;
-    corba_policy.lock_policy = RTT::corba::CLockPolicy(policy.lock_policy);
+    corba_policy.lock_policy = lockPolicyToCORBA(policy.lock_policy);
     corba_policy.pull        = policy.pull;
     corba_policy.size        = policy.size;
     corba_policy.data_size   = policy.data_size;
     corba_policy.transport   = policy.transport;
     corba_policy.name_id     = CORBA::string_dup( policy.name_id.c_str() );
+    corba_policy.oneway      = policy.oneway;
     return corba_policy;
 }
 
@@ -64,11 +105,12 @@ RTT::ConnPolicy toRTT(RTT::corba::CConnPolicy const& corba_policy)
     RTT::ConnPolicy policy;
     policy.type        = corba_policy.type;
     policy.init        = corba_policy.init;
-    policy.lock_policy = corba_policy.lock_policy;
+    policy.lock_policy = lockPolicyToRTT(corba_policy.lock_policy);
     policy.pull        = corba_policy.pull;
     policy.size        = corba_policy.size;
     policy.data_size   = corba_policy.data_size;
     policy.transport   = corba_policy.transport;
     policy.name_id     = corba_policy.name_id;
+    policy.oneway      = corba_policy.oneway;
     return policy;
 }
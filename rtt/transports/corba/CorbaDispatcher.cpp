@@ -40,9 +40,10 @@
 
 namespace RTT {
     using namespace corba;
-    CorbaDispatcher::DispatchMap CorbaDispatcher::DispatchI;
+    CorbaDispatcher::DispatchPool CorbaDispatcher::PoolI;
     RTT_CORBA_API os::Mutex* CorbaDispatcher::mlock = 0;
 
     int CorbaDispatcher::defaultScheduler = ORO_SCHED_RT;
     int CorbaDispatcher::defaultPriority  = os::LowestPriority;
+    unsigned int CorbaDispatcher::poolSize = 4;
 }
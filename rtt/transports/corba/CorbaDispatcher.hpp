@@ -35,7 +35,6 @@
  *                                                                         *
  ***************************************************************************/
 
-
 #ifndef ORO_CORBA_DISPATCHER_HPP
 #define ORO_CORBA_DISPATCHER_HPP
 
@@ -47,38 +46,58 @@
 #include "DataFlowI.h"
 #include "../../DataFlowInterface.hpp"
 #include "../../TaskContext.hpp"
+#include <algorithm>
+#include <sstream>
+#include <vector>
 
 namespace RTT {
     namespace corba {
         /**
          * This object sends over data flow messages
          * from local buffers to a remote channel element.
+         *
+         * The dispatchers form a pool of a fixed number of threads,
+         * which is shared by all data flow interfaces of this process.
+         * Remote channels are sharded over the pool by their destination,
+         * the remote channel element, such that all samples for one
+         * destination are served in order by the same thread, and the
+         * channels of one busy interface spread over the pool. A remote
+         * channel is queued at most once: signals arriving while it waits
+         * for transfer are coalesced into that one transfer, which sends
+         * all samples pending at that time.
          */
         class CorbaDispatcher : public Activity
         {
-            typedef std::map<DataFlowInterface*,CorbaDispatcher*> DispatchMap;
-            RTT_CORBA_API static DispatchMap DispatchI;
+            typedef std::vector<CorbaDispatcher*> DispatchPool;
+            RTT_CORBA_API static DispatchPool PoolI;
 
             typedef internal::List<base::ChannelElementBase::shared_ptr> RCList;
             RCList RClist;
 
             bool do_exit;
 
+            /**
+             * The number of remote channels registered with this
+             * dispatcher, which is the capacity reserved in RClist.
+             */
+            unsigned int mchannels;
+
             RTT_CORBA_API static os::Mutex* mlock;
 
             RTT_CORBA_API static int defaultScheduler;
             RTT_CORBA_API static int defaultPriority;
+            RTT_CORBA_API static unsigned int poolSize;
 
             CorbaDispatcher( const std::string& name)
             : Activity(defaultScheduler, defaultPriority, 0.0, 0, name),
-              RClist(20,2),
-              do_exit(false)
+              RClist(20),
+              do_exit(false), mchannels(0)
               {}
 
             CorbaDispatcher( const std::string& name, int scheduler, int priority)
             : Activity(scheduler, priority, 0.0, 0, name),
-              RClist(20,2),
-              do_exit(false)
+              RClist(20),
+              do_exit(false), mchannels(0)
               {}
 
             ~CorbaDispatcher() {
@@ -87,82 +106,118 @@ namespace RTT {
 
         public:
             /**
-             * Create a new dispatcher for a given data flow interface.
-             * This method will only lock and allocate when a new dispatcher must be created,
-             * otherwise, the access is lock-free and real-time.
-             * One dispatcher per \a iface is created.
-             * @param iface The interface to dispatch data flow messages for.
-             * @return
+             * Sets the number of dispatch threads. This only has effect
+             * before the first dispatcher is created, or after ReleaseAll().
+             * @param size The number of threads, at least 1.
+             * @return false if the pool already exists or \a size is zero.
              */
-            static CorbaDispatcher* Instance(DataFlowInterface* iface, int scheduler = defaultScheduler, int priority = defaultPriority) {
-                if (!mlock)
-                    mlock = new os::Mutex();
-                DispatchMap::iterator result = DispatchI.find(iface);
-                if ( result == DispatchI.end() ) {
-                    os::MutexLock lock(*mlock);
-                    // re-try to find (avoid race):
-                    result = DispatchI.find(iface);
-                    if ( result != DispatchI.end() )
-                        return result->second;
-                    // *really* not found, let's create it.
-                    std::string name;
-                    if ( iface == 0 || iface->getOwner() == 0)
-                        name = "Global";
-                    else
-                        name = iface->getOwner()->getName();
-                    name += ".CorbaDispatch";
-                    DispatchI[iface] = new CorbaDispatcher( name, scheduler, priority );
-                    DispatchI[iface]->start();
-                    return DispatchI[iface];
-                }
-                return result->second;
+            static bool SetPoolSize(unsigned int size) {
+                if ( size == 0 || !PoolI.empty() )
+                    return false;
+                poolSize = size;
+                return true;
             }
 
             /**
-             * Releases and cleans up a specific interface from dispatching.
-             * @param iface
+             * Returns the number of dispatch threads of the pool.
              */
-            static void Release(DataFlowInterface* iface) {
-                DispatchMap::iterator result = DispatchI.find(iface);
-                if ( result != DispatchI.end() ) {
-                    os::MutexLock lock(*mlock);
-                    delete result->second;
-                    DispatchI.erase(result);
+            static unsigned int GetPoolSize() {
+                return poolSize;
+            }
+
+            /**
+             * Returns the dispatcher which serves a given destination.
+             * The dispatch threads are shared by all destinations, at most
+             * GetPoolSize() threads are created.
+             * @param destination The remote channel element to dispatch
+             * data flow messages to.
+             * @param scheduler The scheduler of the dispatch thread, if it
+             * needs to be created.
+             * @param priority The priority of the dispatch thread, if it
+             * needs to be created.
+             * @note Not real-time, channels keep the dispatcher returned by
+             * RegisterChannel() instead.
+             */
+            static CorbaDispatcher* Instance(CRemoteChannelElement_ptr destination, int scheduler = defaultScheduler, int priority = defaultPriority) {
+                if (!mlock)
+                    mlock = new os::Mutex();
+                os::MutexLock lock(*mlock);
+                if ( PoolI.empty() )
+                    PoolI.resize(poolSize, 0);
+                // the hash of an object reference is computed locally.
+                unsigned int slot = destination->_hash( PoolI.size() - 1 );
+                if ( PoolI[slot] == 0 ) {
+                    std::stringstream name;
+                    name << "CorbaDispatch." << slot;
+                    PoolI[slot] = new CorbaDispatcher( name.str(), scheduler, priority );
+                    PoolI[slot]->start();
                 }
-                if ( DispatchI.empty() )
-                    delete mlock;
-                mlock = 0;
+                return PoolI[slot];
             }
 
             /**
              * May be called during program termination to clean up all resources.
+             * Remote channels must not signal any more after this call.
              */
             static void ReleaseAll() {
-                DispatchMap::iterator result = DispatchI.begin();
-                while ( result != DispatchI.end() ) {
-                    delete result->second;
-                    DispatchI.erase(result);
-                    result = DispatchI.begin();
-                }
+                for (DispatchPool::iterator it = PoolI.begin(); it != PoolI.end(); ++it)
+                    delete *it;
+                PoolI.clear();
                 delete mlock;
                 mlock = 0;
             }
 
-	    static void hasElement(base::ChannelElementBase::shared_ptr c0, base::ChannelElementBase::shared_ptr c1, bool& result)
-	    {
-		result = result || (c0 == c1);
-	    }
+            /**
+             * Makes room for a remote channel in the dispatcher of
+             * \a destination, such that it can always queue all of its
+             * channels.
+             * @return the dispatcher the channel must use.
+             * @note Not real-time.
+             */
+            static CorbaDispatcher* RegisterChannel(CRemoteChannelElement_ptr destination) {
+                CorbaDispatcher* disp = Instance(destination);
+                os::MutexLock lock(*mlock);
+                disp->RClist.grow(1);
+                ++disp->mchannels;
+                return disp;
+            }
+
+            /**
+             * Releases the room of a remote channel in the dispatcher
+             * returned by RegisterChannel(). Does nothing if that
+             * dispatcher was released meanwhile.
+             * @note Not real-time.
+             */
+            static void DeregisterChannel(CorbaDispatcher* disp) {
+                if (!mlock || !disp)
+                    return;
+                os::MutexLock lock(*mlock);
+                if ( std::find(PoolI.begin(), PoolI.end(), disp) == PoolI.end() || disp->mchannels == 0 )
+                    return;
+                disp->RClist.shrink(1);
+                --disp->mchannels;
+            }
 
+            /**
+             * Queues \a chan for transfer, unless it is already queued.
+             * @note Real-time.
+             */
             void dispatchChannel( base::ChannelElementBase::shared_ptr chan ) {
-		bool has_element = false;
-		RClist.apply(boost::bind(&CorbaDispatcher::hasElement, _1, chan, boost::ref(has_element)));
-                if (!has_element)
-	            RClist.append( chan );
+                CRemoteChannelElement_i* rbase = dynamic_cast<CRemoteChannelElement_i*>(chan.get());
+                // the pending transfer will also send this sample.
+                if ( rbase && !rbase->setPending() )
+                    return;
+                if ( !RClist.append( chan ) && rbase )
+                    rbase->clearPending();
                 this->trigger();
             }
 
             void cancelChannel( base::ChannelElementBase::shared_ptr chan ) {
-                RClist.erase( chan );
+                if ( RClist.erase( chan ) ) {
+                    CRemoteChannelElement_i* rbase = dynamic_cast<CRemoteChannelElement_i*>(chan.get());
+                    if (rbase)
+                        rbase->clearPending();
+                }
             }
 
             bool initialize() {
@@ -174,10 +229,13 @@ namespace RTT {
             void loop() {
                 while ( !RClist.empty() && !do_exit) {
                     base::ChannelElementBase::shared_ptr chan = RClist.front();
+                    RClist.erase( chan );
                     CRemoteChannelElement_i* rbase = dynamic_cast<CRemoteChannelElement_i*>(chan.get());
-                    if (rbase)
+                    if (rbase) {
+                        // signals from here on queue the channel again.
+                        rbase->clearPending();
                         rbase->transferSamples();
-                    RClist.erase( chan );
+                    }
                 }
             }
 
@@ -39,12 +39,15 @@
 #include "CorbaOperationCallerFactory.hpp"
 #include "AnyDataSource.hpp"
 #include "CorbaLib.hpp"
+#include "CorbaSendQueue.hpp"
 
 #include "../../types/Types.hpp"
 #include "../../internal/DataSources.hpp"
 #include "../../internal/DataSourceCommand.hpp"
 #include "../../SendStatus.hpp"
 #include "../../Handle.hpp"
+#include <boost/weak_ptr.hpp>
+#include <list>
 
 using namespace std;
 using namespace RTT;
@@ -54,22 +57,37 @@ CorbaOperationCallerFactory::CorbaOperationCallerFactory( const std::string& met
     : RTT::OperationInterfacePart(),
       mfact(corba::CService::_duplicate(fact) ),
       mpoa(PortableServer::POA::_duplicate(the_poa)),
-      method(method_name)
+      method(method_name), mcached(false)
+{}
+
+CorbaOperationCallerFactory::CorbaOperationCallerFactory( const corba::COperationDescription& signature, corba::CService_ptr fact, PortableServer::POA_ptr the_poa )
+    : RTT::OperationInterfacePart(),
+      mfact(corba::CService::_duplicate(fact) ),
+      mpoa(PortableServer::POA::_duplicate(the_poa)),
+      method(signature.name.in()), msig(signature), mcached(true)
 {}
 
 CorbaOperationCallerFactory::~CorbaOperationCallerFactory() {}
 
 unsigned int CorbaOperationCallerFactory::arity()  const {
+    if (mcached)
+        return msig.arity;
     return mfact->getArity( method.c_str() );
 }
 
 unsigned int CorbaOperationCallerFactory::collectArity()  const {
+    if (mcached)
+        return msig.collect_arity;
     return mfact->getCollectArity( method.c_str() );
 }
 
 const TypeInfo* CorbaOperationCallerFactory::getArgumentType(unsigned int i) const {
     try {
-        CORBA::String_var tname = mfact->getArgumentType( method.c_str(), i);
+        CORBA::String_var tname;
+        if ( mcached && i < msig.argument_types.length() )
+            tname = CORBA::string_dup( msig.argument_types[i].in() );
+        else
+            tname = mfact->getArgumentType( method.c_str(), i);
         if ( Types()->type( tname.in() ) != 0 )
             return Types()->type( tname.in() );
         // locally unknown type:
@@ -87,6 +105,8 @@ const TypeInfo* CorbaOperationCallerFactory::getArgumentType(unsigned int i) con
 }
 
 const TypeInfo* CorbaOperationCallerFactory::getCollectType(unsigned int i) const {
+    if ( mcached && i >= 1 && i <= msig.collect_types.length() )
+        return Types()->type( msig.collect_types[i-1].in() );
     try {
         CORBA::String_var tname = mfact->getCollectType( method.c_str(), i);
         return Types()->type( tname.in() );
@@ -97,6 +117,8 @@ const TypeInfo* CorbaOperationCallerFactory::getCollectType(unsigned int i) cons
 
 
 std::string CorbaOperationCallerFactory::resultType() const {
+    if (mcached)
+        return std::string( msig.result_type.in() );
     try {
         CORBA::String_var result = mfact->getResultType( method.c_str() );
         return std::string( result.in() );
@@ -111,6 +133,8 @@ std::string CorbaOperationCallerFactory::getName() const {
 }
 
 std::string CorbaOperationCallerFactory::description() const {
+    if (mcached)
+        return std::string( msig.description.in() );
     try {
         CORBA::String_var result = mfact->getDescription( method.c_str() );
         return std::string( result.in() );
@@ -122,6 +146,14 @@ std::string CorbaOperationCallerFactory::description() const {
 
 std::vector< ArgumentDescription > CorbaOperationCallerFactory::getArgumentList() const {
     CDescriptions ret;
+    if (mcached) {
+        ret.reserve( msig.arguments.length() );
+        for (size_t i=0; i!= msig.arguments.length(); ++i)
+            ret.push_back( ArgumentDescription(std::string( msig.arguments[i].name.in() ),
+                                                          std::string( msig.arguments[i].description.in() ),
+                                                          std::string( msig.arguments[i].type.in() ) ));
+        return ret;
+    }
     try {
         corba::CDescriptions_var result = mfact->getArguments( method.c_str() );
         ret.reserve( result->length() );
@@ -154,6 +186,8 @@ class CorbaOperationCallerCall: public ActionInterface
     // The type transporter for the return value
     CorbaTypeTransporter* mctt;
     bool mdocall;
+    // The sent requests which may still inform mcaller.
+    std::list< boost::weak_ptr<CorbaSendRequest> > msent;
 public:
     CorbaOperationCallerCall(CService_ptr fact,
                     std::string op,
@@ -165,6 +199,15 @@ public:
     {
     }
 
+    ~CorbaOperationCallerCall() {
+        // The caller goes away, its engine must no longer be informed.
+        for (std::list< boost::weak_ptr<CorbaSendRequest> >::iterator it = msent.begin(); it != msent.end(); ++it) {
+            CorbaSendRequest::shared_ptr req = it->lock();
+            if (req)
+                req->detach();
+        }
+    }
+
     void readArguments() {
         // We need to delay reading the arguments upto this point such that the args contain
         // the latest values.
@@ -192,11 +235,25 @@ public:
                 if (mctt)
                     return mctt->updateFromAny(&any.in(), mresult);
             } else {
-                CSendHandle_var sh = mfact->sendOperation( mop.c_str(), nargs.in() );
-                AssignableDataSource<CSendHandle_var>::shared_ptr ads = AssignableDataSource<CSendHandle_var>::narrow( mresult.get() );
+                // the remote call is done by the CorbaSendQueue, which informs mcaller when done.
+                CorbaSendRequest::shared_ptr req( new CorbaSendRequest( mfact.in(), mop, nargs._retn(), mcaller ) );
+                AssignableDataSource<CorbaSendRequest::shared_ptr>::shared_ptr ads = AssignableDataSource<CorbaSendRequest::shared_ptr>::narrow( mresult.get() );
                 if (ads) {
-                    ads->set( sh ); // _var creates a copy of the obj reference.
+                    ads->set( req );
+                }
+                if ( !CorbaSendQueue::Send( req ) ) {
+                    log(Error) << "Too many operations in flight, could not send '" << mop << "'." << endlog();
+                    req->cancel();
+                    return false;
                 }
+                for (std::list< boost::weak_ptr<CorbaSendRequest> >::iterator it = msent.begin(); it != msent.end(); ) {
+                    CorbaSendRequest::shared_ptr done = it->lock();
+                    if ( !done || done->isDone() )
+                        it = msent.erase(it);
+                    else
+                        ++it;
+                }
+                msent.push_back( req );
             }
             return true;
         } catch ( corba::CNoSuchNameException& ) {
@@ -282,9 +339,9 @@ base::DataSourceBase::shared_ptr CorbaOperationCallerFactory::produceSend(const
     try {
         // will throw if wrong args.
         mfact->checkOperation(method.c_str(), nargs.inout() );
-        // Will return a CSendHandle_var:
-        DataSource<CSendHandle_var>::shared_ptr result = new ValueDataSource<CSendHandle_var>();
-        return new ActionAliasDataSource<CSendHandle_var>(new CorbaOperationCallerCall(mfact.in(),method,args,caller, 0, result, false), result.get() );
+        // Will return a CorbaSendRequest::shared_ptr:
+        DataSource<CorbaSendRequest::shared_ptr>::shared_ptr result = new ValueDataSource<CorbaSendRequest::shared_ptr>();
+        return new ActionAliasDataSource<CorbaSendRequest::shared_ptr>(new CorbaOperationCallerCall(mfact.in(),method,args,caller, 0, result, false), result.get() );
     } catch ( corba::CNoSuchNameException& nsn ) {
         throw  name_not_found_exception( nsn.name.in() );
     } catch ( corba::CWrongNumbArgException& wa ) {
@@ -296,8 +353,8 @@ base::DataSourceBase::shared_ptr CorbaOperationCallerFactory::produceSend(const
 }
 
 base::DataSourceBase::shared_ptr CorbaOperationCallerFactory::produceHandle() const {
-    // collect expects a handle of this type. Also send returns a CSendHandle_var, which can be copied into this handle object.
-    return new ValueDataSource<CSendHandle_var>();
+    // collect expects a handle of this type. Also send returns a CorbaSendRequest::shared_ptr, which can be copied into this handle object.
+    return new ValueDataSource<CorbaSendRequest::shared_ptr>();
 }
 
 /**
@@ -310,101 +367,79 @@ base::DataSourceBase::shared_ptr CorbaOperationCallerFactory::produceHandle() co
  */
 class CorbaOperationCallerCollect: public DataSource<SendStatus>
 {
-    CSendHandle_var msh;
+    DataSource<CorbaSendRequest::shared_ptr>::shared_ptr mhandle;
     std::vector<base::DataSourceBase::shared_ptr> margs;
     DataSource<bool>::shared_ptr misblocking;
     mutable SendStatus mss;
 public:
-    CorbaOperationCallerCollect(CSendHandle_ptr sh,
+    CorbaOperationCallerCollect(DataSource<CorbaSendRequest::shared_ptr>::shared_ptr handle,
                        std::vector<base::DataSourceBase::shared_ptr> const& args,
                        DataSource<bool>::shared_ptr isblocking)
-    : msh( CSendHandle::_duplicate(sh)), margs(args), misblocking(isblocking), mss(SendFailure)
+    : mhandle(handle), margs(args), misblocking(isblocking), mss(SendFailure)
     {
     }
 
-    ~CorbaOperationCallerCollect() {
-    	try {
-    		msh->dispose();
-    	} catch(...) {}
-    }
-
     SendStatus value() const { return mss; }
 
     SendStatus const& rvalue() const { return mss; }
 
     SendStatus get() const {
-        try {
-            // only try to collect if we didn't do so before:
-            if ( mss != SendSuccess ) {
-                corba::CAnyArguments_var nargs;
-                if ( misblocking->get() ) {
-                    mss = SendStatus( static_cast<int>(msh->collect( nargs.out() ) ) - 1 );
-                } else {
-                    mss = SendStatus( static_cast<int>(msh->collectIfDone( nargs.out() ) ) - 1 );
-                }
-                // only convert results when we got a success:
-                if (mss == SendSuccess) {
-                    assert( nargs->length() ==  margs.size() );
-                    for (size_t i=0; i < margs.size(); ++i ) {
-                        const types::TypeInfo* ti = margs[i]->getTypeInfo();
-                        CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) );
-                        assert( ctt );
-                        ctt->updateFromAny( &nargs[i], margs[i] );
-                    }
+        // only try to collect if we didn't do so before:
+        if ( mss != SendSuccess ) {
+            CorbaSendRequest::shared_ptr req = mhandle->get();
+            if ( !req )
+                return mss = SendFailure;
+            if ( misblocking->get() )
+                req->wait();
+            mss = req->status();
+            // only convert results when we got a success:
+            if (mss == SendSuccess) {
+                const corba::CAnyArguments& nargs = req->results();
+                assert( nargs.length() ==  margs.size() );
+                for (size_t i=0; i < margs.size(); ++i ) {
+                    const types::TypeInfo* ti = margs[i]->getTypeInfo();
+                    CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) );
+                    assert( ctt );
+                    ctt->updateFromAny( &nargs[i], margs[i] );
                 }
             }
-            return mss;
-        }  catch ( corba::CWrongNumbArgException& ) {
-            return mss;
-        } catch ( corba::CWrongTypeArgException& ) {
-            return mss;
-        } catch ( corba::CCallError& e) {
-            throw std::runtime_error(std::string(e.what.in()));
+            if (mss == SendFailure && !req->error().empty())
+                throw std::runtime_error( req->error() );
         }
+        return mss;
     }
 
-    DataSource<SendStatus>* clone() const { return new CorbaOperationCallerCollect(CSendHandle::_duplicate( msh.in() ), margs, misblocking); }
+    DataSource<SendStatus>* clone() const { return new CorbaOperationCallerCollect(mhandle, margs, misblocking); }
 
     virtual DataSource<SendStatus>* copy( std::map<const DataSourceBase*, DataSourceBase*>& alreadyCloned ) const {
         vector<DataSourceBase::shared_ptr> argcopy( margs.size() );
         unsigned int v=0;
         for (vector<DataSourceBase::shared_ptr>::iterator it = argcopy.begin(); it != argcopy.end(); ++it, ++v)
             argcopy[v] = (*it)->copy(alreadyCloned);
-        return new CorbaOperationCallerCollect(CSendHandle::_duplicate( msh.in() ), argcopy, misblocking);
+        return new CorbaOperationCallerCollect(mhandle->copy(alreadyCloned), argcopy, misblocking);
     }
 };
 
 
 base::DataSourceBase::shared_ptr CorbaOperationCallerFactory::produceCollect(const std::vector<base::DataSourceBase::shared_ptr>& args, internal::DataSource<bool>::shared_ptr blocking) const {
-    unsigned int expected = mfact->getCollectArity(method.c_str());
+    unsigned int expected = this->collectArity();
     if (args.size() !=  expected + 1) {
         throw wrong_number_of_args_exception( expected + 1, args.size() );
     }
-    // isolate and check CSendHandle
+    // isolate and check the send request
     std::vector<base::DataSourceBase::shared_ptr> cargs( ++args.begin(), args.end() );
-    DataSource<CSendHandle_var>::shared_ptr ds = DataSource<CSendHandle_var>::narrow( args.begin()->get() );
+    DataSource<CorbaSendRequest::shared_ptr>::shared_ptr ds = DataSource<CorbaSendRequest::shared_ptr>::narrow( args.begin()->get() );
     if (!ds) {
-        throw wrong_types_of_args_exception(0,"CSendHandle_var",(*args.begin())->getTypeName() );
+        throw wrong_types_of_args_exception(0,"CorbaSendRequest",(*args.begin())->getTypeName() );
     }
-    // check if args matches what CSendHandle expects.
-    try {
-        corba::CAnyArguments_var nargs = new corba::CAnyArguments();
-        nargs->length( cargs.size() );
-        for (size_t i=0; i < cargs.size(); ++i ) {
-            const types::TypeInfo* ti = cargs[i]->getTypeInfo();
-            CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>( ti->getProtocol(ORO_CORBA_PROTOCOL_ID) );
-            assert( ctt );
-            DataSourceBase::shared_ptr tryout = ti->buildValue();
-            ctt->updateAny(tryout, nargs[i]);
-        }
-        ds->get()->checkArguments( nargs.in() );
-    } catch ( CWrongNumbArgException& wna) {
-        throw wrong_number_of_args_exception(wna.wanted, wna.received);
-    } catch ( CWrongTypeArgException& wta) {
-        throw wrong_types_of_args_exception(wta.whicharg,wta.expected.in(), wta.received.in());
+    // check if args matches what the operation returns.
+    for (size_t i=0; i < cargs.size(); ++i ) {
+        const types::TypeInfo* ti = this->getCollectType( i + 1 );
+        if ( ti && ti != cargs[i]->getTypeInfo() )
+            throw wrong_types_of_args_exception( i + 1, ti->getTypeName(), cargs[i]->getTypeName() );
     }
     // All went well, produce collect DataSource:
-    return new CorbaOperationCallerCollect( ds->get().in(),cargs, blocking);
+    return new CorbaOperationCallerCollect( ds, cargs, blocking);
 }
 
 #ifdef ORO_SIGNALLING_OPERATIONS
@@ -65,6 +65,11 @@ namespace RTT
         corba::CService_var mfact;
         PortableServer::POA_var mpoa;
         std::string method;
+        /**
+         * The signature, when it was given at construction time.
+         */
+        corba::COperationDescription msig;
+        bool mcached;
     public:
         typedef std::vector<base::DataSourceBase::shared_ptr> CArguments;
         typedef std::vector<std::string> Members;
@@ -72,6 +77,14 @@ namespace RTT
 
         CorbaOperationCallerFactory( const std::string& method_name, corba::CService_ptr fact, PortableServer::POA_ptr the_poa );
 
+        /**
+         * Creates a factory of which the signature is already known,
+         * such that arity(), resultType(), getArgumentList() etc. don't
+         * need to query the remote service.
+         * @param signature The signature as obtained from CService::getServiceDescriptions().
+         */
+        CorbaOperationCallerFactory( const corba::COperationDescription& signature, corba::CService_ptr fact, PortableServer::POA_ptr the_poa );
+
         virtual ~CorbaOperationCallerFactory();
 
         /**
@@ -0,0 +1,291 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  CorbaSendQueue.cpp
+
+                        CorbaSendQueue.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "CorbaSendQueue.hpp"
+#include "../../base/DisposableInterface.hpp"
+#include "../../os/MutexLock.hpp"
+#include "../../os/fosi.h"
+#include "../../Logger.hpp"
+#include <boost/bind.hpp>
+#include <sstream>
+
+namespace RTT
+{
+    namespace corba
+    {
+        namespace {
+            /**
+             * Wakes up the caller of a CorbaSendRequest, just like the
+             * 'returned' message of a local send.
+             */
+            class CorbaSendReturn : public base::DisposableInterface
+            {
+            public:
+                void executeAndDispose() { dispose(); }
+                void dispose() { delete this; }
+            };
+        }
+
+        CorbaSendRequest::CorbaSendRequest(CService_ptr serv, const std::string& op, CAnyArguments* args, ExecutionEngine* caller)
+            : mserv( CService::_duplicate(serv) ), mop(op), margs(args), mcaller(caller), mstatus(SendNotReady), mdone(false)
+        {
+        }
+
+        void CorbaSendRequest::run()
+        {
+            SendStatus ss = SendFailure;
+            try {
+                CSendHandle_var sh = mserv->sendOperation( mop.c_str(), margs.in() );
+                ss = SendStatus( static_cast<int>( sh->collect( mresults.out() ) ) - 1 );
+                try {
+                    sh->dispose();
+                } catch(...) {}
+            } catch ( CCallError& e ) {
+                merror = e.what.in();
+            } catch ( CORBA::Exception& e ) {
+                log(Error) << "caught CORBA exception while sending operation '" << mop << "': " << e._name() << endlog();
+            }
+            complete( ss );
+        }
+
+        void CorbaSendRequest::cancel()
+        {
+            complete( SendFailure );
+        }
+
+        void CorbaSendRequest::complete(SendStatus ss)
+        {
+            // detach() waits until the caller has been informed.
+            os::MutexLock lock(mlock);
+            mstatus = ss;
+            mdone = true;
+            mcond.broadcast();
+            if ( mcaller ) {
+                CorbaSendReturn* msg = new CorbaSendReturn();
+                if ( !mcaller->process( msg, mcaller->getSendLane() ) )
+                    delete msg;
+            }
+        }
+
+        void CorbaSendRequest::detach()
+        {
+            os::MutexLock lock(mlock);
+            mcaller = 0;
+        }
+
+        bool CorbaSendRequest::isDone() const
+        {
+            return mdone;
+        }
+
+        void CorbaSendRequest::wait()
+        {
+            if ( mdone )
+                return;
+            if ( mcaller && mcaller->getActivity() && mcaller->getActivity()->thread()->isSelf() ) {
+                mcaller->waitForMessages( boost::bind(&CorbaSendRequest::isDone, this) );
+                return;
+            }
+            os::MutexLock lock(mlock);
+            while ( !mdone )
+                mcond.wait(mlock);
+        }
+
+        SendStatus CorbaSendRequest::status() const
+        {
+            return mdone ? mstatus : SendNotReady;
+        }
+
+        const CAnyArguments& CorbaSendRequest::results() const
+        {
+            return mresults.in();
+        }
+
+        const std::string& CorbaSendRequest::error() const
+        {
+            return merror;
+        }
+
+        class CorbaSendQueue::Worker : public Activity
+        {
+            CorbaSendQueue* mq;
+        public:
+            Worker(CorbaSendQueue* q, const std::string& name)
+                : Activity(ORO_SCHED_RT, os::LowestPriority, 0.0, 0, name), mq(q)
+            {}
+
+            ~Worker() {
+                this->stop();
+            }
+
+            void loop() {
+                while ( !mq->mexit ) {
+                    mq->mpending.wait();
+                    CorbaSendRequest* req = 0;
+                    if ( mq->mexit || !mq->mqueue.dequeue( req ) )
+                        continue;
+                    CorbaSendRequest::shared_ptr keep;
+                    keep.swap( req->mkeep );
+                    keep->run();
+                    mq->finished();
+                }
+                mq->mactive.dec();
+            }
+
+            bool breakLoop() {
+                // CorbaSendQueue::stop() wakes up all threads.
+                return mq->mexit;
+            }
+        };
+
+        os::Mutex CorbaSendQueue::minstance_lock;
+        CorbaSendQueue* CorbaSendQueue::minstance = 0;
+        os::AtomicInt CorbaSendQueue::msenders(0);
+        unsigned int CorbaSendQueue::mwindow = 32;
+
+        CorbaSendQueue::CorbaSendQueue()
+            : mqueue( mwindow ), minflight(0), mpending(0), mexit(false), mactive(0)
+        {
+            for (unsigned int i = 0; i != mwindow; ++i) {
+                std::stringstream name;
+                name << "CorbaSend." << i;
+                mworkers.push_back( new Worker(this, name.str()) );
+                mactive.inc();
+                if ( !mworkers.back()->start() )
+                    mactive.dec();
+            }
+        }
+
+        CorbaSendQueue::~CorbaSendQueue()
+        {
+            for (unsigned int i = 0; i != mworkers.size(); ++i)
+                delete mworkers[i];
+        }
+
+        bool CorbaSendQueue::stop(Seconds grace)
+        {
+            mexit = true;
+            oro_mb();
+            for (unsigned int i = 0; i != mworkers.size(); ++i)
+                mpending.signal();
+            // the requests no thread took any more will never be sent.
+            CorbaSendRequest* req = 0;
+            while ( mqueue.dequeue( req ) ) {
+                CorbaSendRequest::shared_ptr keep;
+                keep.swap( req->mkeep );
+                keep->cancel();
+                finished();
+            }
+            TIME_SPEC ts = ticks2timespec( nano2ticks( 1000000 ) );
+            for (int waited = 0; mactive.read() != 0 && waited < int(grace * 1000); ++waited)
+                rtos_nanosleep( &ts, 0 );
+            return mactive.read() == 0;
+        }
+
+        void CorbaSendQueue::finished()
+        {
+            minflight.dec();
+        }
+
+        bool CorbaSendQueue::Send(CorbaSendRequest::shared_ptr req)
+        {
+            // Release() waits for msenders before it deletes the instance.
+            CorbaSendQueue* q = 0;
+            while ( true ) {
+                msenders.inc();
+                oro_mb();
+                q = minstance;
+                if ( q )
+                    break;
+                msenders.dec();
+                os::MutexLock lock(minstance_lock);
+                if ( !minstance )
+                    minstance = new CorbaSendQueue();
+            }
+            bool sent = false;
+            q->minflight.inc();
+            if ( q->minflight.read() <= int(mwindow) && !q->mexit ) {
+                req->mkeep = req;
+                sent = q->mqueue.enqueue( req.get() );
+                if ( sent )
+                    q->mpending.signal();
+                else
+                    req->mkeep.reset();
+            }
+            if ( !sent )
+                q->minflight.dec();
+            msenders.dec();
+            return sent;
+        }
+
+        bool CorbaSendQueue::SetWindow(unsigned int window)
+        {
+            os::MutexLock lock(minstance_lock);
+            if ( window == 0 || minstance )
+                return false;
+            mwindow = window;
+            return true;
+        }
+
+        unsigned int CorbaSendQueue::GetWindow()
+        {
+            return mwindow;
+        }
+
+        void CorbaSendQueue::Release()
+        {
+            CorbaSendQueue* q = 0;
+            {
+                os::MutexLock lock(minstance_lock);
+                q = minstance;
+                minstance = 0;
+            }
+            if ( !q )
+                return;
+            oro_mb();
+            TIME_SPEC ts = ticks2timespec( nano2ticks( 100000 ) );
+            while ( msenders.read() != 0 )
+                rtos_nanosleep( &ts, 0 );
+            if ( q->stop( 1.0 ) )
+                delete q;
+            else
+                log(Warning) << "CorbaSendQueue: not waiting for " << q->mactive.read()
+                             << " threads blocked in a remote call, they exit when their call returns." << endlog();
+        }
+    }
+}
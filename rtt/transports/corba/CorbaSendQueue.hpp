@@ -0,0 +1,213 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  CorbaSendQueue.hpp
+
+                        CorbaSendQueue.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CORBA_SEND_QUEUE_HPP
+#define ORO_CORBA_SEND_QUEUE_HPP
+
+#include "corba.h"
+#include "ServiceC.h"
+#include "../../Activity.hpp"
+#include "../../ExecutionEngine.hpp"
+#include "../../SendStatus.hpp"
+#include "../../os/Atomic.hpp"
+#include "../../os/Mutex.hpp"
+#include "../../os/Condition.hpp"
+#include "../../os/Semaphore.hpp"
+#include "../../internal/AtomicQueue.hpp"
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace RTT
+{
+    namespace corba
+    {
+        /**
+         * One remote operation which was sent with CorbaSendQueue::Send().
+         * The remote call is done by a thread of the CorbaSendQueue, which
+         * then queues a message in the caller's ExecutionEngine, like a
+         * local send does, such that the caller never blocks on the ORB
+         * and is woken up when the results are in.
+         */
+        class RTT_CORBA_API CorbaSendRequest
+        {
+        public:
+            typedef boost::shared_ptr<CorbaSendRequest> shared_ptr;
+
+            /**
+             * @param serv The service which hosts the operation.
+             * @param op The name of the operation.
+             * @param args The arguments of the operation. Ownership is taken.
+             * @param caller The engine to deliver the completion to.
+             */
+            CorbaSendRequest(CService_ptr serv, const std::string& op, CAnyArguments* args, ExecutionEngine* caller);
+
+            /**
+             * Sends the operation, waits for its results and
+             * informs the caller. Called by a CorbaSendQueue thread.
+             */
+            void run();
+
+            /**
+             * Marks this request as failed without sending it.
+             */
+            void cancel();
+
+            /**
+             * Forgets the caller's engine, such that the completion is no
+             * longer delivered to it. Called before the caller goes away,
+             * waits for a delivery in progress.
+             */
+            void detach();
+
+            /**
+             * Returns true when the results may be read with status() and results().
+             */
+            bool isDone() const;
+
+            /**
+             * Waits until isDone(). Processes the messages of the
+             * caller's engine when called from its thread.
+             */
+            void wait();
+
+            /**
+             * SendNotReady while not done, then SendSuccess or SendFailure.
+             */
+            SendStatus status() const;
+
+            /**
+             * The collected return value and reference arguments, valid when
+             * status() is SendSuccess.
+             */
+            const CAnyArguments& results() const;
+
+            /**
+             * The error raised by the remote operation, or empty.
+             */
+            const std::string& error() const;
+
+        private:
+            friend class CorbaSendQueue;
+            /**
+             * Publishes the outcome and informs the caller.
+             */
+            void complete(SendStatus ss);
+
+            /**
+             * Keeps this request alive while it is queued or being sent.
+             */
+            shared_ptr mkeep;
+            CService_var mserv;
+            std::string mop;
+            CAnyArguments_var margs;
+            CAnyArguments_var mresults;
+            ExecutionEngine* mcaller;
+            SendStatus mstatus;
+            std::string merror;
+            volatile bool mdone;
+            os::Mutex mlock;
+            os::Condition mcond;
+        };
+
+        /**
+         * A pool of threads which performs the remote calls of
+         * CorbaSendRequest objects. There is one thread per request of
+         * the window, so GetWindow() requests can be in flight at the
+         * same time and a slow remote operation only holds up its own
+         * thread. Sending more fails immediately instead of blocking the
+         * sender.
+         */
+        class RTT_CORBA_API CorbaSendQueue
+        {
+        public:
+            /**
+             * Queues a request for sending.
+             * @return false if the window is full.
+             * @note Does not block on the ORB. The first call creates the threads.
+             */
+            static bool Send(CorbaSendRequest::shared_ptr req);
+
+            /**
+             * Sets the maximum number of requests in flight, which is also
+             * the number of threads sending them. This only has effect
+             * before the first Send(), or after Release().
+             * @return false if the pool already exists or \a window is zero.
+             */
+            static bool SetWindow(unsigned int window);
+
+            static unsigned int GetWindow();
+
+            /**
+             * Stops the threads and cancels the requests that were not sent
+             * yet. Threads which are still blocked in a remote call after a
+             * grace period are not waited for: they exit when their call
+             * returns, and their resources are not reclaimed.
+             */
+            static void Release();
+
+        private:
+            class Worker;
+            CorbaSendQueue();
+            ~CorbaSendQueue();
+            void finished();
+            /**
+             * Makes the threads exit and waits at most \a grace for them.
+             * @return false if some threads are still in a remote call.
+             */
+            bool stop(Seconds grace);
+
+            internal::AtomicQueue<CorbaSendRequest*> mqueue;
+            os::AtomicInt minflight;
+            /** Counts the queued requests, the threads wait on it */
+            os::Semaphore mpending;
+            volatile bool mexit;
+            /** The number of threads which did not exit yet */
+            os::AtomicInt mactive;
+            std::vector<Worker*> mworkers;
+
+            static os::Mutex minstance_lock;
+            static CorbaSendQueue* minstance;
+            /** The number of Send() calls using minstance */
+            static os::AtomicInt msenders;
+            static unsigned int mwindow;
+        };
+    }
+}
+
+#endif
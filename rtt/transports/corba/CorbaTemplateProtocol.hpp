@@ -150,6 +150,16 @@ namespace RTT
                   return base::DataSourceBase::shared_ptr( new DataSourceProxy<PropertyType>( serv, vname, false ) );
               }
           }
+
+          virtual base::DataSourceBase::shared_ptr createKnownPropertyDataSource(CService_ptr serv, const std::string& vname) {
+              return base::DataSourceBase::shared_ptr( new ValueDataSourceProxy<PropertyType>( serv, vname, true, false) );
+          }
+
+          virtual base::DataSourceBase::shared_ptr createKnownAttributeDataSource(CService_ptr serv, const std::string& vname, bool assignable) {
+              if ( assignable )
+                  return base::DataSourceBase::shared_ptr( new ValueDataSourceProxy<PropertyType>( serv, vname, false, false) );
+              return base::DataSourceBase::shared_ptr( new DataSourceProxy<PropertyType>( serv, vname, false, false ) );
+          }
       };
 }
 }
@@ -98,6 +98,19 @@ namespace RTT {
          */
         virtual base::DataSourceBase::shared_ptr createPropertyDataSource(CService_ptr serv, const std::string& vname) = 0;
         virtual base::DataSourceBase::shared_ptr createAttributeDataSource(CService_ptr serv, const std::string& vname) = 0;
+
+        /**
+         * Same as above, for a property or attribute of which the existence
+         * and assignability are already known from CService::getServiceDescriptions(),
+         * such that the data source needs not to check these remotely.
+         * The default implementation forwards to the functions above.
+         */
+        virtual base::DataSourceBase::shared_ptr createKnownPropertyDataSource(CService_ptr serv, const std::string& vname) {
+            return createPropertyDataSource(serv, vname);
+        }
+        virtual base::DataSourceBase::shared_ptr createKnownAttributeDataSource(CService_ptr serv, const std::string& vname, bool /*assignable*/) {
+            return createAttributeDataSource(serv, vname);
+        }
 	};
     }
 }
@@ -53,6 +53,7 @@
 
 #include "RemotePorts.hpp"
 #include "RemoteConnID.hpp"
+#include "CorbaDispatcher.hpp"
 #include <rtt/os/MutexLock.hpp>
 
 #include <iostream>
@@ -470,6 +471,7 @@ CChannelElement_ptr CDataFlowInterface_i::buildChannelInput(
     CRemoteChannelElement_i* this_element;
     PortableServer::ServantBase_var servant = this_element = transporter->createChannelElement_i(mdf, mpoa, corba_policy.pull);
     this_element->setCDataFlowInterface(this);
+    this_element->setOneway(corba_policy.oneway && !corba_policy.pull);
 
     // Attach the corba channel element first (so OOB is after corba).
     assert( dynamic_cast<ChannelElementBase*>(this_element) );
@@ -582,12 +584,22 @@ CRemoteChannelElement_i::CRemoteChannelElement_i(RTT::corba::CorbaTypeTransporte
     : transport(transport)
     , mpoa(PortableServer::POA::_duplicate(poa))
     , mdataflow(0)
+    , mdispatcher(0)
+    , mpending(0)
+    , moneway(false)
     { }
-CRemoteChannelElement_i::~CRemoteChannelElement_i() {}
+CRemoteChannelElement_i::~CRemoteChannelElement_i()
+{ CorbaDispatcher::DeregisterChannel(mdispatcher); }
 PortableServer::POA_ptr CRemoteChannelElement_i::_default_POA()
 { return PortableServer::POA::_duplicate(mpoa); }
 void CRemoteChannelElement_i::setRemoteSide(CRemoteChannelElement_ptr remote) ACE_THROW_SPEC ((
 	      CORBA::SystemException
 	    ))
-{ this->remote_side = RTT::corba::CRemoteChannelElement::_duplicate(remote); }
+{
+    // Make room for this channel in the dispatcher of its destination
+    // before signal() can use it.
+    CorbaDispatcher::DeregisterChannel(mdispatcher);
+    mdispatcher = CORBA::is_nil(remote) ? 0 : CorbaDispatcher::RegisterChannel(remote);
+    this->remote_side = RTT::corba::CRemoteChannelElement::_duplicate(remote);
+}
 
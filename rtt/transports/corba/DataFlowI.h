@@ -50,6 +50,7 @@
 #include "CorbaTypeTransporter.hpp"
 #include <list>
 #include <rtt/os/Mutex.hpp>
+#include <rtt/os/CAS.hpp>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
@@ -60,6 +61,7 @@ namespace RTT {
 
     namespace corba {
         class CDataFlowInterface_i;
+        class CorbaDispatcher;
 
         /**
          * Base class for CORBA channel servers.
@@ -75,6 +77,19 @@ namespace RTT {
             RTT::corba::CorbaTypeTransporter const& transport;
             PortableServer::POA_var mpoa;
             CDataFlowInterface_i* mdataflow;
+            /**
+             * The dispatcher which serves remote_side, zero as long as
+             * no remote side is set.
+             */
+            CorbaDispatcher* mdispatcher;
+            /**
+             * Non-zero while this channel is queued in the CorbaDispatcher.
+             */
+            volatile int mpending;
+            /**
+             * Set if pushed samples are sent with the oneway calls.
+             */
+            bool moneway;
 
         public:
             // standard constructor
@@ -90,6 +105,29 @@ namespace RTT {
 
             virtual void transferSamples() = 0;
 
+            /**
+             * Marks this channel as queued for transferSamples().
+             * @return false if it was already queued.
+             */
+            bool setPending() {
+                return os::CAS(&mpending, 0, 1);
+            }
+
+            /**
+             * Clears the mark of setPending(), before its samples are transferred.
+             */
+            void clearPending() {
+                mpending = 0;
+                oro_mb();
+            }
+
+            /**
+             * Selects the oneway calls for pushing samples to the remote side.
+             */
+            void setOneway(bool oneway) {
+                moneway = oneway;
+            }
+
             void setCDataFlowInterface(CDataFlowInterface_i* dataflow) {
                 mdataflow = dataflow;
             }
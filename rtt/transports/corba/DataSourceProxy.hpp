@@ -45,6 +45,7 @@
 #include "CorbaConversion.hpp"
 #include "CorbaTypeTransporter.hpp"
 #include "CorbaLib.hpp"
+#include "RemoteValueCache.hpp"
 #include <cassert>
 
 namespace RTT
@@ -61,10 +62,13 @@ namespace RTT
         };
         /**
          * Mirrors a remote DataSource.
+         * When a RemoteValueCache is attached, get() returns the
+         * cached value and only contacts the remote side when the
+         * cache is stale or disabled.
          */
         template<class T>
         class DataSourceProxy
-            : public internal::DataSource<T>
+            : public internal::DataSource<T>, public RemoteValueCacheClient
         {
             corba::CService_var mserv;
             const std::string mname;
@@ -78,20 +82,21 @@ namespace RTT
              * @param s The service to use
              * @param name The name of attribute or property
              * @param isproperty set to true if name refers to a property, to false if it referes to an attribute.
+             * @param check set to false if the existence of \a name is already known, to save a remote call.
              *
              * @throw NonExistingDataSource when name does not exist in s as a property (isproperty==true)
              * or attribute (isproperty==false).
              */
-            DataSourceProxy( corba::CService_ptr s, const std::string& name, bool isproperty )
+            DataSourceProxy( corba::CService_ptr s, const std::string& name, bool isproperty, bool check = true )
                 : mserv( corba::CService::_duplicate( s ) ), mname(name), misproperty(isproperty)
             {
                 assert( !CORBA::is_nil(s) );
                 types::TypeTransporter* tp = this->getTypeInfo()->getProtocol(ORO_CORBA_PROTOCOL_ID);
                 ctp = dynamic_cast<corba::CorbaTypeTransporter*>(tp);
                 assert( ctp ); // only call this from CorbaTempateTypeInfo.
-                if ( misproperty && ! mserv->hasProperty( name.c_str()))
+                if ( check && misproperty && ! mserv->hasProperty( name.c_str()))
                     throw NonExistingDataSource();
-                if ( !misproperty && ! mserv->hasAttribute( name.c_str()))
+                if ( check && !misproperty && ! mserv->hasAttribute( name.c_str()))
                     throw NonExistingDataSource();
             }
 
@@ -104,21 +109,25 @@ namespace RTT
             }
 
             virtual typename internal::DataSource<T>::result_t get() const {
+                internal::ReferenceDataSource<T> rds(last_value);
+                rds.ref();
+                if ( mcache && mcache->update( mcacheindex, ctp, &rds ) )
+                    return last_value;
                 CORBA::Any_var res;
                 if ( misproperty ) {
                     res = mserv->getProperty( mname.c_str() );
                 } else {
                     res = mserv->getAttribute( mname.c_str() );
                 }
-                internal::ReferenceDataSource<T> rds(last_value);
-                rds.ref();
                 if ( ctp->updateFromAny(&res.in(),&rds ) == false)
                     Logger::log() <<Logger::Error << "Could not update DataSourceProxy from remote value!"<<Logger::endl;
                 return last_value;
             }
 
             virtual internal::DataSource<T>* clone() const {
-                return new DataSourceProxy<T>( corba::CService::_duplicate( mserv.in() ), mname, misproperty );
+                DataSourceProxy<T>* ret = new DataSourceProxy<T>( corba::CService::_duplicate( mserv.in() ), mname, misproperty );
+                ret->setValueCache( mcache, mcacheindex );
+                return ret;
             }
 
             virtual internal::DataSource<T>* copy( std::map<const base::DataSourceBase*, base::DataSourceBase*>& alreadyCloned ) const {
@@ -136,10 +145,12 @@ namespace RTT
 
         /**
          * Mirrors a remote assignable value datasource.
+         * Reads may be served from a RemoteValueCache, writes
+         * always go to the remote side and invalidate the cache.
          */
         template<class T>
         class ValueDataSourceProxy
-            : public internal::AssignableDataSource<T>
+            : public internal::AssignableDataSource<T>, public RemoteValueCacheClient
         {
             typedef typename internal::AssignableDataSource<T>::value_t value_t;
             corba::CService_var mserv;
@@ -150,7 +161,10 @@ namespace RTT
             //mutable typename internal::DataSource<T>::value_t last_value;
 
         public:
-            ValueDataSourceProxy( corba::CService_ptr serv, const std::string& name, bool isproperty)
+            /**
+             * @see DataSourceProxy::DataSourceProxy
+             */
+            ValueDataSourceProxy( corba::CService_ptr serv, const std::string& name, bool isproperty, bool check = true)
                 : mserv( corba::CService::_duplicate(serv) ), mname(name), misproperty(isproperty)
             {
                 storage = new internal::ValueDataSource<value_t>();
@@ -158,9 +172,9 @@ namespace RTT
                 types::TypeTransporter* tp = this->getTypeInfo()->getProtocol(ORO_CORBA_PROTOCOL_ID);
                 ctp = dynamic_cast<corba::CorbaTypeTransporter*>(tp);
                 assert(ctp);
-                if ( misproperty && !mserv->hasProperty( name.c_str()) )
+                if ( check && misproperty && !mserv->hasProperty( name.c_str()) )
                     throw NonExistingDataSource();
-                if ( !misproperty && ( !mserv->hasAttribute( name.c_str())  || !mserv->isAttributeAssignable( name.c_str()) ))
+                if ( check && !misproperty && ( !mserv->hasAttribute( name.c_str())  || !mserv->isAttributeAssignable( name.c_str()) ))
                     throw NonExistingDataSource();
                 this->get(); // initialize such that value()/rvalue() return a sane value !
             }
@@ -175,14 +189,16 @@ namespace RTT
 
 
             virtual typename internal::DataSource<T>::result_t get() const {
+                internal::ReferenceDataSource<T> rds( storage->set() );
+                rds.ref();
+                if ( mcache && mcache->update( mcacheindex, ctp, &rds ) )
+                    return storage->rvalue();
                 CORBA::Any_var res;
                 if ( misproperty ) {
                     res = mserv->getProperty( mname.c_str() );
                 } else {
                     res = mserv->getAttribute( mname.c_str() );
                 }
-                internal::ReferenceDataSource<T> rds( storage->set() );
-                rds.ref();
                 if ( ctp->updateFromAny(&res.in(), &rds ) == false)
                     Logger::log() <<Logger::Error << "Could not update ValueDataSourceProxy from remote value!"<<Logger::endl;
                 return storage->rvalue();
@@ -197,6 +213,8 @@ namespace RTT
                 } else {
                     mserv->setAttribute( mname.c_str(), toset.in() );
                 }
+                if ( mcache )
+                    mcache->invalidate();
                 storage->set( t );
             }
 
@@ -211,7 +229,9 @@ namespace RTT
             }
 
             virtual internal::AssignableDataSource<T>* clone() const {
-                return new ValueDataSourceProxy<T>( corba::CService::_duplicate( mserv.in() ), mname, misproperty );
+                ValueDataSourceProxy<T>* ret = new ValueDataSourceProxy<T>( corba::CService::_duplicate( mserv.in() ), mname, misproperty );
+                ret->setValueCache( mcache, mcacheindex );
+                return ret;
             }
 
             virtual internal::AssignableDataSource<T>* copy( std::map<const base::DataSourceBase*, base::DataSourceBase*>& alreadyCloned ) const {
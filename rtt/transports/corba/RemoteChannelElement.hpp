@@ -82,6 +82,11 @@ namespace RTT {
              */
             CORBA::Any* write_any;
 
+            /** This is used on the writing side, to send all pending samples
+             * of a buffered connection in one call. It only grows.
+             */
+            CSampleSequence write_batch;
+
             PortableServer::ObjectId_var oid;
 
 	public:
@@ -106,8 +111,7 @@ namespace RTT {
                 // 1
                 this->ref();
                 oid = mpoa->activate_object(this);
-                // Force creation of dispatcher.
-                CorbaDispatcher::Instance(msender);
+                // The dispatcher is chosen when the remote side is set.
             }
 
             ~RemoteChannelElement()
@@ -136,12 +140,12 @@ namespace RTT {
                 // forward too.
                 base::ChannelElementBase::signal();
                 // intercept signal if no remote side set.
-                if ( CORBA::is_nil(remote_side.in()) )
+                if ( CORBA::is_nil(remote_side.in()) || !mdispatcher )
                     return true;
                 // Remember that signal() is called in the context of the one
                 // that wrote the data, so we must decouple here to keep hard-RT happy.
                 // the dispatch thread must read the data and send it over by calling transferSample().
-                CorbaDispatcher::Instance(msender)->dispatchChannel( this );
+                mdispatcher->dispatchChannel( this );
 
                 return valid;
             }
@@ -167,18 +171,61 @@ namespace RTT {
                         valid = false;
                     }
                 } else {
-                    //log(Debug) <<"...read..."<<endlog();
-                    while ( this->read(sample, false) == NewData && valid) {
-                        //log(Debug) <<"...write..."<<endlog();
-                        if ( this->write(sample) == false )
-                            valid = false;
-                        //log(Debug) <<"...next read?..."<<endlog();
+                    // Collect what is pending in the local buffer and send it
+                    // in one call. A data connection has at most one sample.
+                    CORBA::ULong count = 0;
+                    while ( valid && base::ChannelElement<T>::read(sample, false) == NewData ) {
+                        if ( count == write_batch.length() )
+                            write_batch.length( count + 1 );
+                        const_ref_data_source->setPointer(&sample);
+                        transport.updateAny(const_ref_data_source, write_batch[count]);
+                        ++count;
                     }
+                    if ( count != 0 && valid )
+                        valid = sendBatch(count);
                 }
                 //log(Debug) <<"... done." <<endlog();
 
             }
 
+            /**
+             * Sends the first \a count samples of write_batch to the remote side.
+             */
+            bool sendBatch(CORBA::ULong count) {
+                try
+                {
+                    if ( count == 1 ) {
+                        if ( moneway ) {
+                            remote_side->writeOneway(write_batch[0]);
+                            return true;
+                        }
+                        return remote_side->write(write_batch[0]);
+                    }
+                    // the buffer of the sequence is kept when shrinking it.
+                    CORBA::ULong length = write_batch.length();
+                    write_batch.length(count);
+                    bool result = true;
+                    if ( moneway )
+                        remote_side->writeBatchOneway(write_batch);
+                    else
+                        result = remote_side->writeBatch(write_batch);
+                    write_batch.length(length);
+                    return result;
+                }
+#ifdef CORBA_IS_OMNIORB
+                catch(CORBA::SystemException& e)
+                {
+                    log(Error) << "caught CORBA exception while marshalling: " << e._name() << " " << e.NP_minorString() << endlog();
+                    return false;
+                }
+#endif
+                catch(CORBA::Exception& e)
+                {
+                    log(Error) << "caught CORBA exception while marshalling: " << e._name() << endlog();
+                    return false;
+                }
+            }
+
             /**
              * CORBA IDL function.
              */
@@ -317,7 +364,10 @@ namespace RTT {
                     // (the stack "owns" the object)
                     const_ref_data_source->setPointer(&sample);
                     transport.updateAny(const_ref_data_source, *write_any);
-                    remote_side->write(*write_any); 
+                    if ( moneway )
+                        remote_side->writeOneway(*write_any);
+                    else
+                        remote_side->write(*write_any);
                     return true;
                 }
 #ifdef CORBA_IS_OMNIORB
@@ -345,6 +395,41 @@ namespace RTT {
                 return base::ChannelElement<T>::write(value_data_source->rvalue());
             }
 
+            /**
+             * CORBA IDL function.
+             */
+            bool writeBatch(const CSampleSequence& samples) ACE_THROW_SPEC ((
+          	      CORBA::SystemException
+          	    ))
+            {
+                bool result = true;
+                for (CORBA::ULong i = 0; i != samples.length(); ++i) {
+                    transport.updateFromAny(&samples[i], value_data_source);
+                    result = base::ChannelElement<T>::write(value_data_source->rvalue()) && result;
+                }
+                return result;
+            }
+
+            /**
+             * CORBA IDL function.
+             */
+            void writeOneway(const ::CORBA::Any& sample) ACE_THROW_SPEC ((
+          	      CORBA::SystemException
+          	    ))
+            {
+                this->write(sample);
+            }
+
+            /**
+             * CORBA IDL function.
+             */
+            void writeBatchOneway(const CSampleSequence& samples) ACE_THROW_SPEC ((
+          	      CORBA::SystemException
+          	    ))
+            {
+                this->writeBatch(samples);
+            }
+
             virtual bool data_sample(typename base::ChannelElement<T>::param_t sample)
             {
                 // we don't pass it on through CORBA (yet).
@@ -151,6 +151,7 @@ RTT::base::ChannelElementBase::shared_ptr RemoteInputPort::buildRemoteChannelOut
     CRemoteChannelElement_i*  local =
         static_cast<CorbaTypeTransporter*>(type->getProtocol(ORO_CORBA_PROTOCOL_ID))
                             ->createChannelElement_i(output_port.getInterface(), mpoa, policy.pull);
+    local->setOneway(policy.oneway && !policy.pull);
 
     CRemoteChannelElement_var proxy = local->_this();
     local->setRemoteSide(remote);
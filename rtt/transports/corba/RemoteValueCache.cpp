@@ -0,0 +1,115 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  RemoteValueCache.cpp
+
+                        RemoteValueCache.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "RemoteValueCache.hpp"
+#include "CorbaTypeTransporter.hpp"
+#include "CorbaLib.hpp"
+#include "../../os/MutexLock.hpp"
+#include "../../Logger.hpp"
+
+namespace RTT
+{
+    namespace corba
+    {
+        RemoteValueCache::RemoteValueCache(CService_ptr serv, Seconds staleness)
+            : mserv( CService::_duplicate(serv) ), mstaleness(staleness), mstamp(0), mvalid(false)
+        {
+        }
+
+        int RemoteValueCache::add(const std::string& name, bool isproperty)
+        {
+            os::MutexLock lock(mlock);
+            CConfigurationInterface::CValueNames& names = isproperty ? mproperties : mattributes;
+            CORBA::ULong n = names.length();
+            names.length(n + 1);
+            names[n] = CORBA::string_dup( name.c_str() );
+            mitems.push_back( std::make_pair(isproperty, n) );
+            mvalid = false;
+            return mitems.size() - 1;
+        }
+
+        bool RemoteValueCache::update(int index, CorbaTypeTransporter* ctp, base::DataSourceBase::shared_ptr target)
+        {
+            os::MutexLock lock(mlock);
+            if ( mstaleness <= 0 || index < 0 || index >= int(mitems.size()) )
+                return false;
+            if ( !mvalid || os::TimeService::Instance()->secondsSince(mstamp) > mstaleness ) {
+                if ( !refresh() )
+                    return false;
+            }
+            CORBA::ULong i = mitems[index].second;
+            if ( !mitems[index].first )
+                i += mproperties.length();
+            return ctp->updateFromAny( &mvalues[i], target );
+        }
+
+        void RemoteValueCache::invalidate()
+        {
+            os::MutexLock lock(mlock);
+            mvalid = false;
+        }
+
+        void RemoteValueCache::setStaleness(Seconds staleness)
+        {
+            os::MutexLock lock(mlock);
+            mstaleness = staleness;
+            mvalid = false;
+        }
+
+        Seconds RemoteValueCache::getStaleness() const
+        {
+            return mstaleness;
+        }
+
+        bool RemoteValueCache::refresh()
+        {
+            try {
+                mvalues = mserv->getValues( mproperties, mattributes );
+            }
+            catch(CORBA::Exception& e)
+            {
+                log(Error) << "caught CORBA exception while refreshing remote values: " << e._name() << endlog();
+                mvalid = false;
+                return false;
+            }
+            mstamp = os::TimeService::Instance()->getTicks();
+            mvalid = mvalues->length() == mproperties.length() + mattributes.length();
+            return mvalid;
+        }
+    }
+}
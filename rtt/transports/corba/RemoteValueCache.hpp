@@ -0,0 +1,152 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  RemoteValueCache.hpp
+
+                        RemoteValueCache.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CORBA_REMOTE_VALUE_CACHE_HPP
+#define ORO_CORBA_REMOTE_VALUE_CACHE_HPP
+
+#include "corba.h"
+#include "ServiceC.h"
+#include "../../os/Mutex.hpp"
+#include "../../os/TimeService.hpp"
+#include "../../base/DataSourceBase.hpp"
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace RTT
+{
+    namespace corba
+    {
+        class CorbaTypeTransporter;
+
+        /**
+         * Keeps a local snapshot of the properties and attributes of a
+         * remote service, such that the DataSourceProxy objects of that
+         * service can be evaluated without a remote call each time.
+         * When a value is read and the snapshot is older than the
+         * staleness, all registered values are fetched in one call with
+         * CConfigurationInterface::getValues().
+         * A staleness of zero disables the cache.
+         */
+        class RTT_CORBA_API RemoteValueCache
+        {
+        public:
+            typedef boost::shared_ptr<RemoteValueCache> shared_ptr;
+
+            /**
+             * @param serv The remote service to mirror.
+             * @param staleness The maximum age of the snapshot, in seconds.
+             */
+            RemoteValueCache(CService_ptr serv, Seconds staleness);
+
+            /**
+             * Registers a property or attribute to be kept in the snapshot.
+             * @param name The (dot-separated) name of a property, or the name of an attribute.
+             * @param isproperty true if \a name is a property.
+             * @return the index to pass to update().
+             */
+            int add(const std::string& name, bool isproperty);
+
+            /**
+             * Updates \a target with the snapshot value of the item \a index,
+             * after refreshing the snapshot if it is too old.
+             * @return false if the cache is disabled or the value is not
+             * available, in which case the caller should fetch it itself.
+             */
+            bool update(int index, CorbaTypeTransporter* ctp, base::DataSourceBase::shared_ptr target);
+
+            /**
+             * Forces a refresh at the next update(), for example
+             * after a value was set.
+             */
+            void invalidate();
+
+            /**
+             * Changes the maximum age of the snapshot. Zero disables the cache.
+             */
+            void setStaleness(Seconds staleness);
+
+            Seconds getStaleness() const;
+
+        private:
+            /**
+             * Fetches all values of the snapshot. Must be called with mlock held.
+             */
+            bool refresh();
+
+            os::Mutex mlock;
+            CService_var mserv;
+            Seconds mstaleness;
+            os::TimeService::ticks mstamp;
+            bool mvalid;
+            CConfigurationInterface::CValueNames mproperties;
+            CConfigurationInterface::CValueNames mattributes;
+            /**
+             * For each item, its index in mvalues. Attributes are stored
+             * after the properties, so these are offset at refresh().
+             */
+            std::vector< std::pair<bool, CORBA::ULong> > mitems;
+            CConfigurationInterface::CValues_var mvalues;
+        };
+
+        /**
+         * Base class of the proxies which can be served from
+         * a RemoteValueCache. The TaskContextProxy attaches the cache
+         * of a service to each proxy it creates for that service.
+         */
+        class RTT_CORBA_API RemoteValueCacheClient
+        {
+        protected:
+            RemoteValueCache::shared_ptr mcache;
+            int mcacheindex;
+        public:
+            RemoteValueCacheClient() : mcacheindex(-1) {}
+            virtual ~RemoteValueCacheClient() {}
+
+            /**
+             * Serve this proxy from item \a index of \a cache.
+             */
+            void setValueCache(RemoteValueCache::shared_ptr cache, int index) {
+                mcache = cache;
+                mcacheindex = index;
+            }
+        };
+    }
+}
+
+#endif
@@ -67,6 +67,8 @@
 // ../../../ACE_wrappers/TAO/TAO_IDL/be/be_codegen.cpp:1196
 
 #include "ServiceI.h"
+#include "../../PropertyBag.hpp"
+#include <boost/functional/hash.hpp>
 
 using namespace RTT;
 using namespace RTT::detail;
@@ -143,3 +145,111 @@ char * RTT_corba_CService_i::getServiceDescription (
 {
     return mservice->hasService( name );
 }
+
+namespace {
+    void hashNames(std::size_t& seed, const std::vector<std::string>& names)
+    {
+        boost::hash_combine( seed, names.size() );
+        boost::hash_range( seed, names.begin(), names.end() );
+    }
+
+    void hashInterface(std::size_t& seed, Service::shared_ptr service)
+    {
+        hashNames( seed, service->getNames() );
+        hashNames( seed, listProperties( *service->properties() ) );
+        hashNames( seed, service->getAttributeNames() );
+        hashNames( seed, service->getPortNames() );
+        Service::ProviderNames names = service->getProviderNames();
+        hashNames( seed, names );
+        for (unsigned int i=0; i != names.size(); ++i )
+            if ( names[i] != "this" && service->getService( names[i] ) )
+                hashInterface( seed, service->getService( names[i] ) );
+    }
+}
+
+void RTT_corba_CService_i::describe( ::RTT::corba::CServiceDescriptions& result, ::CORBA::Long parent, const char* name )
+{
+    CORBA::ULong index = result.length();
+    result.length( index + 1 );
+    {
+        // the reference may move when result grows, so don't keep it beyond this scope.
+        RTT::corba::CServiceDescription& desc = result[index];
+        desc.name = CORBA::string_dup( name );
+        desc.description = CORBA::string_dup( mservice->doc().c_str() );
+        desc.parent = parent;
+        desc.service = POA_RTT::corba::CService::_this();
+
+        RTT::corba::COperationInterface::COperationList_var ops = this->getOperations();
+        desc.operations.length( ops->length() );
+        for (CORBA::ULong i=0; i != ops->length(); ++i) {
+            RTT::corba::COperationDescription& op = desc.operations[i];
+            op.name = CORBA::string_dup( ops[i].in() );
+            op.description = this->getDescription( ops[i].in() );
+            op.result_type = this->getResultType( ops[i].in() );
+            op.arity = this->getArity( ops[i].in() );
+            op.collect_arity = this->getCollectArity( ops[i].in() );
+            RTT::corba::CDescriptions_var args = this->getArguments( ops[i].in() );
+            op.arguments = args.in();
+            op.argument_types.length( op.arity + 1 );
+            for (CORBA::UShort a=0; a <= op.arity; ++a)
+                op.argument_types[a] = this->getArgumentType( ops[i].in(), a );
+            op.collect_types.length( op.collect_arity );
+            for (CORBA::UShort a=1; a <= op.collect_arity; ++a)
+                op.collect_types[a-1] = this->getCollectType( ops[i].in(), a );
+        }
+
+        RTT::corba::CConfigurationInterface::CPropertyNames_var props = this->getPropertyList();
+        desc.properties.length( props->length() );
+        for (CORBA::ULong i=0; i != props->length(); ++i) {
+            desc.properties[i].name = CORBA::string_dup( props[i].name.in() );
+            desc.properties[i].description = CORBA::string_dup( props[i].description.in() );
+            desc.properties[i].type_name = this->getPropertyTypeName( props[i].name.in() );
+        }
+
+        RTT::corba::CConfigurationInterface::CAttributeNames_var attrs = this->getAttributeList();
+        desc.attributes.length( attrs->length() );
+        for (CORBA::ULong i=0; i != attrs->length(); ++i) {
+            desc.attributes[i].name = CORBA::string_dup( attrs[i].in() );
+            desc.attributes[i].type_name = this->getAttributeTypeName( attrs[i].in() );
+            desc.attributes[i].assignable = this->isAttributeAssignable( attrs[i].in() );
+        }
+
+        RTT::corba::CDataFlowInterface::CPortDescriptions_var ports = this->getPortDescriptions();
+        desc.ports = ports.in();
+    }
+
+    Service::ProviderNames names = mservice->getProviderNames();
+    for (unsigned int i=0; i != names.size(); ++i ) {
+        if ( names[i] == "this" )
+            continue;
+        RTT::corba::CService_var child = this->getService( names[i].c_str() );
+        if ( CORBA::is_nil(child) )
+            continue;
+        // getService() stored the servant of the child in mservs:
+        for(Servants::iterator it = mservs.begin(); it != mservs.end(); ++it) {
+            if ( it->first->_is_equivalent( child.in() ) ) {
+                RTT_corba_CService_i* child_i = dynamic_cast<RTT_corba_CService_i*>( it->second.in() );
+                if ( child_i )
+                    child_i->describe( result, index, names[i].c_str() );
+                break;
+            }
+        }
+    }
+}
+
+::RTT::corba::CServiceDescriptions * RTT_corba_CService_i::getServiceDescriptions (
+    ::CORBA::ULong_out version)
+{
+    ::RTT::corba::CServiceDescriptions_var result = new ::RTT::corba::CServiceDescriptions();
+    version = this->getInterfaceVersion();
+    this->describe( result.inout(), -1, mservice->getName().c_str() );
+    return result._retn();
+}
+
+::CORBA::ULong RTT_corba_CService_i::getInterfaceVersion (
+    void)
+{
+    std::size_t seed = 0;
+    hashInterface( seed, mservice );
+    return ::CORBA::ULong( seed );
+}
@@ -97,6 +97,11 @@ protected:
     // child services
     typedef std::vector<std::pair<RTT::corba::CService_var,PortableServer::ServantBase_var> > Servants;
     Servants mservs;
+
+    /**
+     * Appends the description of this service and its children to \a result.
+     */
+    void describe( ::RTT::corba::CServiceDescriptions& result, ::CORBA::Long parent, const char* name );
 public:
   // Constructor 
     RTT_corba_CService_i ( RTT::ServicePtr service, PortableServer::POA_ptr poa);
@@ -131,6 +136,14 @@ public:
   virtual
   ::CORBA::Boolean hasService (
       const char * name);
+
+  virtual
+  ::RTT::corba::CServiceDescriptions * getServiceDescriptions (
+      ::CORBA::ULong_out version);
+
+  virtual
+  ::CORBA::ULong getInterfaceVersion (
+      void);
   
 };
 
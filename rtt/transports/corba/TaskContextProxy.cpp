@@ -59,6 +59,8 @@
 #include <string>
 
 #include "RemotePorts.hpp"
+#include "CorbaSendQueue.hpp"
+#include "../../os/MutexLock.hpp"
 
 using namespace std;
 using namespace RTT::detail;
@@ -79,6 +81,28 @@ namespace RTT
 
     PortableServer::POA_var TaskContextProxy::proxy_poa;
 
+    Seconds TaskContextProxy::cache_staleness = 0;
+
+    TaskContextProxy::DescriptionCache TaskContextProxy::descriptions;
+
+    os::Mutex TaskContextProxy::descriptions_lock;
+
+    void TaskContextProxy::SetCacheStaleness(Seconds staleness)
+    {
+        cache_staleness = staleness;
+    }
+
+    Seconds TaskContextProxy::GetCacheStaleness()
+    {
+        return cache_staleness;
+    }
+
+    void TaskContextProxy::setCacheStaleness(Seconds staleness)
+    {
+        for (std::vector<RemoteValueCache::shared_ptr>::iterator it = value_caches.begin(); it != value_caches.end(); ++it)
+            (*it)->setStaleness( staleness );
+    }
+
     TaskContextProxy::~TaskContextProxy()
     {
         log(Info) << "Terminating TaskContextProxy for " <<  this->getName() <<endlog();
@@ -190,7 +214,8 @@ namespace RTT
             return;
         
         CService_var serv = mtask->getProvider("this");
-        this->fetchServices(this->provides(), serv.in() );
+        if ( !this->fetchDescriptions( serv.in() ) )
+            this->fetchServices(this->provides(), serv.in() );
 
         CServiceRequester_var srq = mtask->getRequester("this");
         this->fetchRequesters(this->requires(), srq.in() );
@@ -243,6 +268,10 @@ namespace RTT
             parent->add( objs[i].in(), new CorbaOperationCallerFactory( objs[i].in(), serv, ProxyPOA() ) );
         }
 
+        // all properties and attributes of this service share one cache:
+        RemoteValueCache::shared_ptr cache( new RemoteValueCache(serv, cache_staleness) );
+        value_caches.push_back( cache );
+
         // first do properties:
         log(Debug) << "Fetching Properties."<<endlog();
         // a dot-separated list of subbags and items
@@ -255,36 +284,8 @@ namespace RTT
                 log(Error) <<"Property "<< string(props[i].name.in()) << " present in getPropertyList() but not accessible."<<endlog();
                 continue;
             }
-           // If the type is known, immediately build the correct property and datasource.
             CORBA::String_var tn = serv->getPropertyTypeName(props[i].name.in());
-            TypeInfo* ti = TypeInfoRepository::Instance()->type( tn.in() );
-
-            // decode the prefix and property name from the given name:
-            string pname = string( props[i].name.in() );
-            pname = pname.substr( pname.rfind(".") + 1 );
-            string prefix = string( props[i].name.in() );
-            if ( prefix.rfind(".") == string::npos ) {
-                prefix.clear();
-            }
-            else {
-                prefix = prefix.substr( 0, prefix.rfind(".") );
-            }
-
-            if ( ti && ti->hasProtocol(ORO_CORBA_PROTOCOL_ID)) {
-                CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>(ti->getProtocol(ORO_CORBA_PROTOCOL_ID));
-                assert(ctt);
-                // data source needs full remote path name
-                DataSourceBase::shared_ptr ds = ctt->createPropertyDataSource( serv, props[i].name.in() );
-                storeProperty( *parent->properties(), prefix, ti->buildProperty( pname, props[i].description.in(), ds));
-                log(Debug) << "Looked up Property " << tn.in() << " "<< pname <<": created."<<endlog();
-            }
-            else {
-                if ( string("PropertyBag") == tn.in() ) {
-                    storeProperty(*parent->properties(), prefix, new Property<PropertyBag>( pname, props[i].description.in()) );
-                    log(Debug) << "Looked up PropertyBag " << tn.in() << " "<< pname <<": created."<<endlog();
-                } else
-                    log(Error) << "Looked up Property " << tn.in() << " "<< pname <<": type not known. Check your RTT_COMPONENT_PATH ( \""<<getenv("RTT_COMPONENT_PATH")<<" \")."<<endlog();
-            }
+            this->createProperty( parent, serv, cache, props[i].name.in(), props[i].description.in(), tn.in(), false );
         }
 
         log(Debug) << "Fetching Attributes."<<endlog();
@@ -296,23 +297,8 @@ namespace RTT
                 log(Error) <<"Attribute '"<< string(attrs[i].in()) << "' present in getAttributeList() but not accessible."<<endlog();
                 continue;
             }
-            // If the type is known, immediately build the correct attribute and datasource,
             CORBA::String_var tn = serv->getAttributeTypeName( attrs[i].in() );
-            TypeInfo* ti = TypeInfoRepository::Instance()->type( tn.in() );
-            if ( ti && ti->hasProtocol(ORO_CORBA_PROTOCOL_ID) ) {
-                log(Debug) << "Looking up Attribute " << tn.in() <<": found!"<<endlog();
-                CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>(ti->getProtocol(ORO_CORBA_PROTOCOL_ID));
-                assert(ctt);
-                // this function should check itself for const-ness of the remote Attribute:
-                DataSourceBase::shared_ptr ds = ctt->createAttributeDataSource( serv, attrs[i].in() );
-                if ( serv->isAttributeAssignable( attrs[i].in() ) )
-                    parent->setValue( ti->buildAttribute( attrs[i].in(), ds));
-                else
-                    parent->setValue( ti->buildConstant( attrs[i].in(), ds));
-            } else {
-                log(Error) << "Looking up Attribute " << tn.in();
-                Logger::log() <<": type not known. Check your RTT_COMPONENT_PATH ( \""<<getenv("RTT_COMPONENT_PATH")<<" \")."<<endlog();
-            }
+            this->createAttribute( parent, serv, cache, attrs[i].in(), tn.in(), serv->isAttributeAssignable( attrs[i].in() ), false );
         }
 
         CService::CProviderNames_var plist = serv->getProviderNames();
@@ -331,42 +317,193 @@ namespace RTT
         }
     }
 
+    void TaskContextProxy::createProperty(Service::shared_ptr parent, CService_ptr serv, RemoteValueCache::shared_ptr cache,
+                                          const char* name, const char* description, const char* type_name, bool known)
+    {
+        // If the type is known, immediately build the correct property and datasource.
+        TypeInfo* ti = TypeInfoRepository::Instance()->type( type_name );
+
+        // decode the prefix and property name from the given name:
+        string pname = string( name );
+        pname = pname.substr( pname.rfind(".") + 1 );
+        string prefix = string( name );
+        if ( prefix.rfind(".") == string::npos ) {
+            prefix.clear();
+        }
+        else {
+            prefix = prefix.substr( 0, prefix.rfind(".") );
+        }
+
+        if ( ti && ti->hasProtocol(ORO_CORBA_PROTOCOL_ID)) {
+            CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>(ti->getProtocol(ORO_CORBA_PROTOCOL_ID));
+            assert(ctt);
+            // data source needs full remote path name
+            DataSourceBase::shared_ptr ds;
+            if ( known )
+                ds = ctt->createKnownPropertyDataSource( serv, name );
+            else
+                ds = ctt->createPropertyDataSource( serv, name );
+            RemoteValueCacheClient* rvc = dynamic_cast<RemoteValueCacheClient*>( ds.get() );
+            if ( rvc )
+                rvc->setValueCache( cache, cache->add( name, true ) );
+            storeProperty( *parent->properties(), prefix, ti->buildProperty( pname, description, ds));
+            log(Debug) << "Looked up Property " << type_name << " "<< pname <<": created."<<endlog();
+        }
+        else {
+            if ( string("PropertyBag") == type_name ) {
+                storeProperty(*parent->properties(), prefix, new Property<PropertyBag>( pname, description) );
+                log(Debug) << "Looked up PropertyBag " << type_name << " "<< pname <<": created."<<endlog();
+            } else
+                log(Error) << "Looked up Property " << type_name << " "<< pname <<": type not known. Check your RTT_COMPONENT_PATH ( \""<<getenv("RTT_COMPONENT_PATH")<<" \")."<<endlog();
+        }
+    }
+
+    void TaskContextProxy::createAttribute(Service::shared_ptr parent, CService_ptr serv, RemoteValueCache::shared_ptr cache,
+                                           const char* name, const char* type_name, bool assignable, bool known)
+    {
+        // If the type is known, immediately build the correct attribute and datasource,
+        TypeInfo* ti = TypeInfoRepository::Instance()->type( type_name );
+        if ( ti && ti->hasProtocol(ORO_CORBA_PROTOCOL_ID) ) {
+            log(Debug) << "Looking up Attribute " << type_name <<": found!"<<endlog();
+            CorbaTypeTransporter* ctt = dynamic_cast<CorbaTypeTransporter*>(ti->getProtocol(ORO_CORBA_PROTOCOL_ID));
+            assert(ctt);
+            DataSourceBase::shared_ptr ds;
+            if ( known )
+                ds = ctt->createKnownAttributeDataSource( serv, name, assignable );
+            else // this function should check itself for const-ness of the remote Attribute:
+                ds = ctt->createAttributeDataSource( serv, name );
+            RemoteValueCacheClient* rvc = dynamic_cast<RemoteValueCacheClient*>( ds.get() );
+            if ( rvc )
+                rvc->setValueCache( cache, cache->add( name, false ) );
+            if ( assignable )
+                parent->setValue( ti->buildAttribute( name, ds));
+            else
+                parent->setValue( ti->buildConstant( name, ds));
+        } else {
+            log(Error) << "Looking up Attribute " << type_name;
+            Logger::log() <<": type not known. Check your RTT_COMPONENT_PATH ( \""<<getenv("RTT_COMPONENT_PATH")<<" \")."<<endlog();
+        }
+    }
+
+    bool TaskContextProxy::fetchDescriptions(CService_ptr serv)
+    {
+        boost::shared_ptr<CServiceDescriptions> descs;
+        try {
+            CORBA::String_var ior = orb->object_to_string( mtask.in() );
+            std::string key( ior.in() );
+            CORBA::ULong version = serv->getInterfaceVersion();
+            {
+                os::MutexLock lock( descriptions_lock );
+                DescriptionCache::iterator it = descriptions.find( key );
+                if ( it != descriptions.end() && it->second.first == version )
+                    descs = it->second.second;
+            }
+            if ( !descs ) {
+                CServiceDescriptions_var fetched = serv->getServiceDescriptions( version );
+                descs.reset( fetched._retn() );
+                os::MutexLock lock( descriptions_lock );
+                descriptions[key] = std::make_pair( version, descs );
+            } else
+                log(Debug) << "Using cached interface description, version " << version << "." <<endlog();
+        }
+        catch (CORBA::BAD_OPERATION&) {
+            log(Debug) << "Remote side does not support getServiceDescriptions(): querying each service."<<endlog();
+            return false;
+        }
+        catch (CORBA::Exception& e) {
+            log(Warning) << "CORBA exception raised while fetching interface description: " << CORBA_EXCEPTION_INFO(e) << endlog();
+            return false;
+        }
+
+        // descriptions are ordered such that a parent comes before its children.
+        std::vector<Service::shared_ptr> services( descs->length() );
+        for (CORBA::ULong i=0; i != descs->length(); ++i) {
+            const CServiceDescription& desc = (*descs)[i];
+            if ( desc.parent < 0 )
+                services[i] = this->provides();
+            else if ( CORBA::ULong(desc.parent) < i && services[desc.parent] ) {
+                services[i] = services[desc.parent]->provides( std::string(desc.name.in()) );
+                services[i]->doc( desc.description.in() );
+            }
+            else
+                continue;
+            this->buildService( services[i], desc );
+        }
+        return true;
+    }
+
+    void TaskContextProxy::buildService(Service::shared_ptr parent, const CServiceDescription& desc)
+    {
+        log(Debug) << "Building "<<parent->getName()<<" Service from its description."<<endlog();
+        CService_ptr serv = desc.service.in();
+
+        this->createPorts(parent, serv, desc.ports);
+
+        for ( CORBA::ULong i=0; i < desc.operations.length(); ++i) {
+            if ( parent->hasMember( string(desc.operations[i].name.in() )))
+                continue; // already added.
+            parent->add( desc.operations[i].name.in(), new CorbaOperationCallerFactory( desc.operations[i], serv, ProxyPOA() ) );
+        }
+
+        RemoteValueCache::shared_ptr cache( new RemoteValueCache(serv, cache_staleness) );
+        value_caches.push_back( cache );
+
+        for (CORBA::ULong i=0; i != desc.properties.length(); ++i) {
+            if ( findProperty( *parent->properties(), string(desc.properties[i].name.in()), "." ) )
+                continue; // previously added.
+            this->createProperty( parent, serv, cache, desc.properties[i].name.in(), desc.properties[i].description.in(), desc.properties[i].type_name.in(), true );
+        }
+
+        for (CORBA::ULong i=0; i != desc.attributes.length(); ++i) {
+            if ( parent->hasAttribute( string(desc.attributes[i].name.in()) ) )
+                continue; // previously added.
+            this->createAttribute( parent, serv, cache, desc.attributes[i].name.in(), desc.attributes[i].type_name.in(), desc.attributes[i].assignable, true );
+        }
+    }
+
     // Fetch remote ports and create local proxies
     void TaskContextProxy::fetchPorts(RTT::Service::shared_ptr parent, CDataFlowInterface_ptr dfact)
     {
         log(Debug) << "Fetching Ports for service "<<parent->getName()<<"."<<endlog();
-        TypeInfoRepository::shared_ptr type_repo = TypeInfoRepository::Instance();
         if (dfact) {
             CDataFlowInterface::CPortDescriptions_var objs = dfact->getPortDescriptions();
-            for ( size_t i=0; i < objs->length(); ++i) {
-                CPortDescription port = objs[i];
-                if (parent->getPort( port.name.in() ))
-                    continue; // already added.
-
-                TypeInfo const* type_info = type_repo->type(port.type_name.in());
-                if (!type_info)
-                {
-                    log(Warning) << "remote port " << port.name
-                        << " has a type that cannot be marshalled over CORBA: " << port.type_name << ". "
-                        << "It is ignored by TaskContextProxy" << endlog();
-                }
+            this->createPorts(parent, dfact, objs.in());
+        }
+    }
+
+    void TaskContextProxy::createPorts(RTT::Service::shared_ptr parent, CDataFlowInterface_ptr dfact, const CDataFlowInterface::CPortDescriptions& objs)
+    {
+        TypeInfoRepository::shared_ptr type_repo = TypeInfoRepository::Instance();
+        for ( size_t i=0; i < objs.length(); ++i) {
+            CPortDescription port = objs[i];
+            if (parent->getPort( port.name.in() ))
+                continue; // already added.
+
+            TypeInfo const* type_info = type_repo->type(port.type_name.in());
+            if (!type_info)
+            {
+                log(Warning) << "remote port " << port.name
+                    << " has a type that cannot be marshalled over CORBA: " << port.type_name << ". "
+                    << "It is ignored by TaskContextProxy" << endlog();
+            }
+            else
+            {
+                PortInterface* new_port;
+                if (port.type == RTT::corba::CInput)
+                    new_port = new RemoteInputPort( type_info, dfact, port.name.in(), ProxyPOA() );
                 else
-                {
-                    PortInterface* new_port;
-                    if (port.type == RTT::corba::CInput)
-                        new_port = new RemoteInputPort( type_info, dfact, port.name.in(), ProxyPOA() );
-                    else
-                        new_port = new RemoteOutputPort( type_info, dfact, port.name.in(), ProxyPOA() );
-
-                    parent->addPort(*new_port);
-                    port_proxies.push_back(new_port); // see comment in definition of port_proxies
-                }
+                    new_port = new RemoteOutputPort( type_info, dfact, port.name.in(), ProxyPOA() );
+
+                parent->addPort(*new_port);
+                port_proxies.push_back(new_port); // see comment in definition of port_proxies
             }
         }
     }
 
     void TaskContextProxy::DestroyOrb()
     {
+        // drop the operations still being sent before the orb goes.
+        CorbaSendQueue::Release();
         try {
             // Destroy the POA, waiting until the destruction terminates
             //poa->destroy (1, 1);
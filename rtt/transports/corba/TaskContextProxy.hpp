@@ -55,7 +55,12 @@
 #include <map>
 #include "TaskContextC.h"
 #include "ApplicationServer.hpp"
+#include "RemoteValueCache.hpp"
+#include "ServiceC.h"
+#include "../../os/Mutex.hpp"
+#include <boost/shared_ptr.hpp>
 #include <list>
+#include <vector>
 
 namespace RTT
 {namespace corba
@@ -108,6 +113,17 @@ namespace RTT
          */
         std::list<base::PortInterface*> port_proxies;
 
+        /**
+         * One cache per remote service, shared by the property and
+         * attribute proxies of that service.
+         */
+        std::vector<RemoteValueCache::shared_ptr> value_caches;
+
+        /**
+         * The staleness given to the caches of new proxies.
+         */
+        static Seconds cache_staleness;
+
         void synchronize();
 
         mutable corba::CTaskContext_var mtask;
@@ -120,6 +136,29 @@ namespace RTT
         void fetchRequesters(ServiceRequester* parent, CServiceRequester_ptr csrq);
         void fetchServices(Service::shared_ptr parent, CService_ptr mtask);
         void fetchPorts(Service::shared_ptr parent, CDataFlowInterface_ptr serv);
+
+        /**
+         * The interface descriptions obtained with CService::getServiceDescriptions(),
+         * keyed by the IOR of the remote task and tagged with the interface version.
+         */
+        typedef std::map<std::string, std::pair<CORBA::ULong, boost::shared_ptr<CServiceDescriptions> > > DescriptionCache;
+        static DescriptionCache descriptions;
+        static os::Mutex descriptions_lock;
+
+        /**
+         * Builds all services of the remote task from a single description,
+         * which is fetched with one remote call, or taken from the cache
+         * if the remote interface version did not change.
+         * @return false if the remote side does not support this, in which case
+         * fetchServices() must be used.
+         */
+        bool fetchDescriptions(CService_ptr serv);
+        void buildService(Service::shared_ptr parent, const CServiceDescription& desc);
+        void createPorts(Service::shared_ptr parent, CDataFlowInterface_ptr dfact, const CDataFlowInterface::CPortDescriptions& ports);
+        void createProperty(Service::shared_ptr parent, CService_ptr serv, RemoteValueCache::shared_ptr cache,
+                            const char* name, const char* description, const char* type_name, bool known);
+        void createAttribute(Service::shared_ptr parent, CService_ptr serv, RemoteValueCache::shared_ptr cache,
+                             const char* name, const char* type_name, bool assignable, bool known);
     public:
         ~TaskContextProxy();
 
@@ -156,6 +195,27 @@ namespace RTT
          */
         static TaskContext* Create(::RTT::corba::CTaskContext_ptr task, bool force_remote = false);
 
+        /**
+         * Sets the staleness of the attribute and property caches of
+         * proxies created after this call. A proxy then returns
+         * values which are at most \a staleness seconds old, and refreshes
+         * all the values of a service in one remote call. The default, zero,
+         * disables caching: each read is a remote call.
+         */
+        static void SetCacheStaleness(Seconds staleness);
+
+        /**
+         * Returns the staleness given to new proxies.
+         */
+        static Seconds GetCacheStaleness();
+
+        /**
+         * Changes the staleness of the attribute and property caches of
+         * this proxy. Zero disables caching.
+         * @see SetCacheStaleness
+         */
+        void setCacheStaleness(Seconds staleness);
+
         /**
          * Get the Corba Object of the CTaskContext.
          * You need to duplicate this object reference in case you wish to keep a reference
@@ -40,7 +40,8 @@
 
 namespace RTT {
     namespace mqueue {
-        Dispatcher* Dispatcher::DispatchI = 0;
+        Dispatcher* Dispatcher::DispatchI[Dispatcher::MaxShards];
+        int Dispatcher::NumShards = 1;
 
         void intrusive_ptr_add_ref(const RTT::mqueue::Dispatcher* p ) {
             p->refcount.inc();
@@ -42,8 +42,19 @@
 #include "../../base/ChannelElementBase.hpp"
 #include "../../Logger.hpp"
 #include <map>
-#include <sys/select.h>
 #include <mqueue.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(OROPKG_OS_GNULINUX)
+// Xenomai mqueues are no Linux file descriptors, so only gnulinux can use epoll.
+# define ORO_MQ_DISPATCH_EPOLL
+# include <sys/epoll.h>
+#else
+# include <sys/select.h>
+#endif
 
 namespace RTT { namespace mqueue { class Dispatcher; } }
 
@@ -56,39 +67,93 @@ namespace RTT {
          * This object waits on a set of open message queue
          * file descriptors and signals the channel that has
          * received new data.
-         * Reasonably, there should be one dispatcher for each
-         * peer component sending us data.
+         *
+         * On gnulinux, the queues are registered once in an edge
+         * triggered epoll set, so adding or removing a queue and waking
+         * up for one queue no longer depends on the number of monitored
+         * queues. Each ready queue is drained completely before waiting
+         * again. Other targets fall back to select().
+         *
+         * By default a single dispatcher thread serves all queues. Call
+         * setShards() before the first connection is made to spread the
+         * queues over a pool of dispatcher threads.
          */
         class Dispatcher : public Activity
         {
             friend void intrusive_ptr_add_ref(const RTT::mqueue::Dispatcher* p );
             friend void intrusive_ptr_release(const RTT::mqueue::Dispatcher* p );
             mutable os::AtomicInt refcount;
-            static Dispatcher* DispatchI;
+
+            enum { MaxShards = 16 };
+            static Dispatcher* DispatchI[MaxShards];
+            static int NumShards;
 
             typedef std::map<mqd_t,base::ChannelElementBase*> MQMap;
             MQMap mqmap;
 
+            /** Index of this dispatcher in DispatchI. */
+            int mshard;
+
+#ifdef ORO_MQ_DISPATCH_EPOLL
+            int epfd;            /* The epoll set with all our queues */
+#else
             fd_set socks;        /* Socket file descriptors we want to wake up for, using select() */
 
             int highsock;        /* Highest #'d file descriptor, needed for select() */
+#endif
 
             bool do_exit;
 
             os::Mutex maplock;
 
-            Dispatcher( const std::string& name)
+            Dispatcher( const std::string& name, int shard)
             : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
-              highsock(0), do_exit(false)
-              {}
+              mshard(shard),
+#ifdef ORO_MQ_DISPATCH_EPOLL
+              epfd( epoll_create(64) ),
+#else
+              highsock(0),
+#endif
+              do_exit(false)
+              {
+#ifdef ORO_MQ_DISPATCH_EPOLL
+                  if (epfd < 0)
+                      log(Error) << "Dispatcher could not create its epoll set: " << strerror(errno) << endlog();
+#endif
+              }
 
             ~Dispatcher() {
                 Logger::In in("Dispatcher");
                 log(Info) << "Dispacher cleans up: no more work."<<endlog();
                 stop();
-                DispatchI = 0;
+#ifdef ORO_MQ_DISPATCH_EPOLL
+                if (epfd >= 0)
+                    close(epfd);
+#endif
+                DispatchI[mshard] = 0;
             }
 
+#ifdef ORO_MQ_DISPATCH_EPOLL
+            /**
+             * Reads all pending messages of \a mqdes. Needed because an
+             * edge triggered queue only reports new arrivals. signal()
+             * also returns false when the next element rejected the sample,
+             * so only stop when the queue is empty or when signal() did
+             * not consume anything, which happens when the channel has no
+             * output (any more).
+             */
+            void drain(mqd_t mqdes, base::ChannelElementBase* chan) {
+                struct mq_attr attr;
+                long left = -1;
+                while ( !do_exit ) {
+                    while ( chan->signal() )
+                        ;
+                    if ( mq_getattr(mqdes, &attr) != 0 || attr.mq_curmsgs == 0 || attr.mq_curmsgs == left )
+                        return;
+                    left = attr.mq_curmsgs;
+                }
+            }
+#else
             void build_select_list() {
 
                 /* First put together fd_set for select(), which will
@@ -127,16 +192,38 @@ namespace RTT {
                     }
                 }
             }
+#endif
 
         public:
             typedef boost::intrusive_ptr<Dispatcher> shared_ptr;
 
-            static Dispatcher::shared_ptr Instance() {
-                if ( DispatchI == 0) {
-                    DispatchI = new Dispatcher("MQueueDispatch");
-                    DispatchI->start();
+            /**
+             * Returns the dispatcher that serves \a mqdes, starting it if
+             * it did not run yet.
+             */
+            static Dispatcher::shared_ptr Instance(mqd_t mqdes = 0) {
+                int shard = int(mqdes) % NumShards;
+                if ( DispatchI[shard] == 0) {
+                    DispatchI[shard] = new Dispatcher("MQueueDispatch", shard);
+                    DispatchI[shard]->start();
                 }
-                return DispatchI;
+                return DispatchI[shard];
+            }
+
+            /**
+             * Sets the number of dispatcher threads, at most 16. Queues
+             * are assigned to a thread by their descriptor. Only takes
+             * effect when no queue is monitored yet.
+             * @return false if queues are being monitored or \a n is out of range.
+             */
+            static bool setShards(int n) {
+                if ( n < 1 || n > MaxShards )
+                    return false;
+                for (int i = 0; i != MaxShards; ++i)
+                    if ( DispatchI[i] )
+                        return false;
+                NumShards = n;
+                return true;
             }
 
             void addQueue( mqd_t mqdes, base::ChannelElementBase* chan ) {
@@ -148,8 +235,21 @@ namespace RTT {
                 log(Debug) <<"Dispatcher is monitoring mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 // we add a refcount per channel we monitor.
-                if (mqmap.count(mqdes) == 0)
+                if (mqmap.count(mqdes) == 0) {
                     refcount.inc();
+#ifdef ORO_MQ_DISPATCH_EPOLL
+                    // draining needs a non blocking receive.
+                    struct mq_attr attr;
+                    attr.mq_flags = O_NONBLOCK;
+                    mq_setattr(mqdes, &attr, 0);
+                    struct epoll_event ev;
+                    ev.events = EPOLLIN | EPOLLET;
+                    ev.data.fd = mqdes;
+                    // adding a queue that already holds messages raises an edge too.
+                    if ( epoll_ctl(epfd, EPOLL_CTL_ADD, mqdes, &ev) != 0 )
+                        log(Error) << "Dispatcher failed to monitor mqdes " << mqdes << ": " << strerror(errno) << endlog();
+#endif
+                }
                 mqmap[mqdes] = chan;
             }
 
@@ -158,6 +258,10 @@ namespace RTT {
                 log(Debug) <<"Dispatcher drops mqdes "<< mqdes <<endlog();
                 os::MutexLock lock(maplock);
                 if (mqmap.count(mqdes)) {
+#ifdef ORO_MQ_DISPATCH_EPOLL
+                    struct epoll_event ev; // ignored, but required before Linux 2.6.9
+                    epoll_ctl(epfd, EPOLL_CTL_DEL, mqdes, &ev);
+#endif
                     mqmap.erase( mqmap.find(mqdes) );
                     refcount.dec();
                 }
@@ -168,6 +272,31 @@ namespace RTT {
                 return true;
             }
 
+#ifdef ORO_MQ_DISPATCH_EPOLL
+            void loop() {
+                enum { MaxEvents = 64 };
+                struct epoll_event events[MaxEvents];
+                while (1) {
+                    // the timeout only bounds the reaction time on breakLoop().
+                    int n = epoll_wait(epfd, events, MaxEvents, 50);
+                    if (n < 0 && errno != EINTR) {
+                        log(Error) <<"Dispatcher failed to wait on message queues. Stopped thread."<<endlog();
+                        return;
+                    }
+                    for (int i = 0; i < n; ++i) {
+                        // look up the channel under the lock, such that it can not
+                        // be removed while we drain it.
+                        os::MutexLock lock(maplock);
+                        MQMap::iterator it = mqmap.find( events[i].data.fd );
+                        if ( it != mqmap.end() )
+                            drain(it->first, it->second);
+                    }
+
+                    if ( do_exit )
+                        return;
+                }
+            }
+#else
             void loop() {
                 struct timeval timeout;  /* Timeout for select */
                 int readsocks;       /* Number of sockets ready for reading */
@@ -204,6 +333,7 @@ namespace RTT {
                         return;
                 } /* while(1) */
             }
+#endif
 
             bool breakLoop() {
                 do_exit = true;
@@ -212,4 +342,3 @@ namespace RTT {
         };
     }
 }
-
@@ -155,7 +155,7 @@ void MQSendRecv::cleanupStream()
     {
         if (minit_done)
         {
-            Dispatcher::Instance()->removeQueue(mqdes);
+            Dispatcher::Instance(mqdes)->removeQueue(mqdes);
             minit_done = false;
         }
     }
@@ -212,7 +212,7 @@ bool MQSendRecv::mqReady(base::DataSourceBase::shared_ptr ds, base::ChannelEleme
             {
                 minit_done = true;
                 // ok, now we can add the dispatcher.
-                Dispatcher::Instance()->addQueue(mqdes, chan);
+                Dispatcher::Instance(mqdes)->addQueue(mqdes, chan);
                 return true;
             }
             else
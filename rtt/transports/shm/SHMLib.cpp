@@ -0,0 +1,80 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  SHMLib.cpp
+
+                        SHMLib.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "SHMLib.hpp"
+#include "SHMTemplateProtocol.hpp"
+#include "../../types/TransportPlugin.hpp"
+#include "../../types/TypekitPlugin.hpp"
+
+using namespace std;
+using namespace RTT::detail;
+
+namespace RTT {
+    namespace shm {
+        bool SHMLibPlugin::registerTransport(std::string name, TypeInfo* ti)
+        {
+            if ( name == "int" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new SHMTemplateProtocol<int>() );
+            if ( name == "double" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new SHMTemplateProtocol<double>() );
+            if ( name == "float" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new SHMTemplateProtocol<float>() );
+            if ( name == "uint" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new SHMTemplateProtocol<unsigned int>() );
+            if ( name == "char" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new SHMTemplateProtocol<char>() );
+            if ( name == "bool" )
+                return ti->addProtocol(ORO_SHM_PROTOCOL_ID, new SHMTemplateProtocol<bool>() );
+            return false;
+        }
+
+        std::string SHMLibPlugin::getTransportName() const {
+            return "shm";
+        }
+
+        std::string SHMLibPlugin::getTypekitName() const {
+            return "rtt-types";
+        }
+        std::string SHMLibPlugin::getName() const {
+            return "rtt-shm-transport";
+        }
+    }
+}
+
+ORO_TYPEKIT_PLUGIN( RTT::shm::SHMLibPlugin )
@@ -0,0 +1,444 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  SHMSendRecv.cpp
+
+                        SHMSendRecv.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <unistd.h>
+#include <sstream>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <errno.h>
+#include <time.h>
+
+#include "SHMSendRecv.hpp"
+#include "../../types/TypeMarshaller.hpp"
+#include "../../Logger.hpp"
+#include "../../Activity.hpp"
+#include "../../base/PortInterface.hpp"
+#include "../../DataFlowInterface.hpp"
+#include "../../TaskContext.hpp"
+#include "../../os/oro_arch.h"
+
+using namespace RTT;
+using namespace RTT::detail;
+using namespace RTT::shm;
+
+namespace RTT
+{
+    namespace shm
+    {
+        /**
+         * The layout of a shared memory segment. The header is followed
+         * by \a slot_count slots of \a slot_stride bytes, each starting
+         * with the length of the sample it holds.
+         *
+         * Only plain integers are stored in here, since os::AtomicInt
+         * is not guaranteed to be process shared on every architecture.
+         * \a head is only written by the sender and \a tail only by the
+         * receiver, which makes ordering with oro_mb() sufficient.
+         */
+        struct SHMSegment
+        {
+            enum { CacheLine = 64 };
+            /** Set to SHMMagic by the creator once the header is valid. */
+            volatile int magic;
+            int slot_size;
+            int slot_count;
+            int slot_stride;
+            char pad0[CacheLine - 4 * sizeof(int)];
+            /** The next slot the sender fills. */
+            volatile int head;
+            char pad1[CacheLine - sizeof(int)];
+            /** The next slot the receiver empties. */
+            volatile int tail;
+            /** Non-zero while the receiver sleeps on \a doorbell. */
+            volatile int waiting;
+            char pad2[CacheLine - 2 * sizeof(int)];
+            /** The futex word, bumped by the sender after each write. */
+            volatile int doorbell;
+            char pad3[CacheLine - sizeof(int)];
+        };
+
+        /**
+         * Waits on the doorbell of a segment and signals the
+         * receiving channel element when samples arrived.
+         */
+        class SHMSendRecv::Receiver : public Activity
+        {
+            SHMSendRecv* mowner;
+            base::ChannelElementBase* mchan;
+            bool do_exit;
+        public:
+            Receiver(SHMSendRecv* owner, base::ChannelElementBase* chan, const std::string& name)
+                : Activity(ORO_SCHED_RT, os::HighestPriority, 0.0, 0, name),
+                  mowner(owner), mchan(chan), do_exit(false)
+            {}
+
+            ~Receiver() {
+                stop();
+            }
+
+            bool initialize() {
+                do_exit = false;
+                return true;
+            }
+
+            void loop() {
+                while ( !do_exit ) {
+                    // the timeout only bounds the time breakLoop() waits
+                    // in case the wake up raced with going to sleep.
+                    if ( mowner->shmWait(0.05) ) {
+                        while ( !do_exit && mowner->shmAvailable() )
+                            mchan->signal();
+                    }
+                }
+            }
+
+            bool breakLoop() {
+                do_exit = true;
+                oro_mb();
+                // we are the only one sleeping on this doorbell.
+                syscall(SYS_futex, &mowner->segment->doorbell, FUTEX_WAKE, 1, 0, 0, 0);
+                return true;
+            }
+        };
+    }
+}
+
+namespace
+{
+    const int SHMMagic = 0x52545453; // "RTTS"
+    const int SHMHeaderSize = sizeof(SHMSegment);
+
+    int round_up(int value, int multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+}
+
+SHMSendRecv::SHMSendRecv(types::TypeMarshaller const& transport) :
+    mtransport(transport), marshaller_cookie(0), shmfd(-1), segment(0), map_size(0), receiver(0),
+    mis_sender(false), minit_done(false), mis_creator(false)
+{
+}
+
+void SHMSendRecv::setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy,
+                              bool is_sender)
+{
+    Logger::In in("SHMSendRecv");
+
+    int slot_size = policy.data_size ? policy.data_size : mtransport.getSampleSize(ds);
+    marshaller_cookie = mtransport.createCookie();
+    mis_sender = is_sender;
+
+    std::stringstream namestr;
+    namestr << '/' << port->getInterface()->getOwner()->getName() << '.' << port->getName() << '.' << this << '@' << getpid();
+
+    if (policy.name_id.empty())
+        policy.name_id = namestr.str();
+
+    if (policy.name_id[0] != '/' || policy.name_id.find('/', 1) != std::string::npos)
+        throw std::runtime_error("Could not open shared memory segment with wrong name. Names must start with '/' and contain no more '/' after the first one.");
+    if (slot_size <= 0)
+        throw std::runtime_error("Could not open shared memory segment with zero sample size.");
+
+    // One slot always stays empty to tell a full ring from an empty one.
+    int slot_count = (policy.size ? policy.size : 10) + 1;
+    int slot_stride = round_up(sizeof(int) + slot_size, sizeof(double));
+
+    // The first one to arrive creates and initializes the segment,
+    // the other side waits until it is ready and adopts its layout.
+    shmfd = shm_open(policy.name_id.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IREAD | S_IWRITE);
+    if (shmfd >= 0)
+    {
+        mis_creator = true;
+        map_size = SHMHeaderSize + slot_count * slot_stride;
+        if (ftruncate(shmfd, map_size) != 0)
+        {
+            log(Error) << "Could not size '" << policy.name_id << "' to " << map_size << " bytes: " << strerror(errno) << endlog();
+            close(shmfd);
+            shm_unlink(policy.name_id.c_str());
+            shmfd = -1;
+            throw std::runtime_error("Could not size shared memory segment: ftruncate returned -1.");
+        }
+        void* addr = mmap(0, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close(shmfd);
+            shm_unlink(policy.name_id.c_str());
+            shmfd = -1;
+            throw std::runtime_error("Could not map shared memory segment: mmap failed.");
+        }
+        segment = static_cast<SHMSegment*>(addr);
+        // ftruncate() zeroed the segment, so head, tail and doorbell are 0.
+        segment->slot_size = slot_size;
+        segment->slot_count = slot_count;
+        segment->slot_stride = slot_stride;
+        oro_mb();
+        segment->magic = SHMMagic;
+    }
+    else if (errno == EEXIST)
+    {
+        shmfd = shm_open(policy.name_id.c_str(), O_RDWR, S_IREAD | S_IWRITE);
+        if (shmfd < 0)
+        {
+            log(Error) << "FAILED opening '" << policy.name_id << "': " << strerror(errno) << endlog();
+            throw std::runtime_error("Could not open shared memory segment: shm_open returned -1.");
+        }
+        // wait for the creator to size and initialize the segment.
+        struct stat st;
+        int tries = 0;
+        while ( fstat(shmfd, &st) == 0 && st.st_size < SHMHeaderSize && ++tries < 100 )
+            usleep(1000);
+        if ( st.st_size < SHMHeaderSize )
+        {
+            close(shmfd);
+            shmfd = -1;
+            throw std::runtime_error("Could not open shared memory segment: it was never initialized.");
+        }
+        map_size = st.st_size;
+        void* addr = mmap(0, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, shmfd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close(shmfd);
+            shmfd = -1;
+            throw std::runtime_error("Could not map shared memory segment: mmap failed.");
+        }
+        segment = static_cast<SHMSegment*>(addr);
+        while ( segment->magic != SHMMagic && ++tries < 200 )
+            usleep(1000);
+        oro_mb();
+        if ( segment->magic != SHMMagic || segment->slot_size <= 0 || segment->slot_count < 2
+             || size_t(segment->slot_stride) < sizeof(int) + size_t(segment->slot_size)
+             || map_size < SHMHeaderSize + size_t(segment->slot_count) * size_t(segment->slot_stride) )
+        {
+            munmap(segment, map_size);
+            segment = 0;
+            close(shmfd);
+            shmfd = -1;
+            throw std::runtime_error("Could not open shared memory segment: it has an invalid layout.");
+        }
+        if ( segment->slot_size < slot_size )
+        {
+            log(Error) << "Segment '" << policy.name_id << "' holds samples of " << segment->slot_size
+                       << " bytes, while this side expects " << slot_size << " bytes." << endlog();
+            munmap(segment, map_size);
+            segment = 0;
+            close(shmfd);
+            shmfd = -1;
+            throw std::runtime_error("Could not open shared memory segment: its samples are too small.");
+        }
+    }
+    else
+    {
+        log(Error) << "FAILED opening '" << policy.name_id << "' for " << (is_sender ? "writing: " : "reading: ") << strerror(errno) << endlog();
+        throw std::runtime_error("Could not open shared memory segment: shm_open returned -1.");
+    }
+
+    log(Debug) << "Opened '" << policy.name_id << "' with slot size '" << segment->slot_size << "' and ring length '"
+               << segment->slot_count - 1 << "' for " << (is_sender ? "writing." : "reading.") << endlog();
+
+    shmname = policy.name_id;
+}
+
+SHMSendRecv::~SHMSendRecv()
+{
+    if (segment)
+        munmap(segment, map_size);
+    if (shmfd >= 0)
+        close(shmfd);
+}
+
+void SHMSendRecv::cleanupStream()
+{
+    if (!mis_sender)
+    {
+        if (receiver)
+        {
+            receiver->stop();
+            delete receiver;
+            receiver = 0;
+        }
+        // a receiver that never saw a sender removes what it created.
+        if (!minit_done && mis_creator)
+            shm_unlink(shmname.c_str());
+        minit_done = false;
+    }
+    else
+    {
+        // sender unlinks to avoid future re-use of new readers.
+        shm_unlink(shmname.c_str());
+    }
+    // both sender and receiver unmap their end.
+    if (segment)
+    {
+        munmap(segment, map_size);
+        segment = 0;
+    }
+    if (shmfd >= 0)
+    {
+        close(shmfd);
+        shmfd = -1;
+    }
+
+    if (marshaller_cookie)
+    {
+        mtransport.deleteCookie(marshaller_cookie);
+        marshaller_cookie = 0;
+    }
+}
+
+char* SHMSendRecv::slot(int i) const
+{
+    return reinterpret_cast<char*>(segment) + SHMHeaderSize + i * segment->slot_stride;
+}
+
+bool SHMSendRecv::shmAvailable() const
+{
+    bool avail = segment->head != segment->tail;
+    oro_mb();
+    return avail;
+}
+
+bool SHMSendRecv::shmWait(double timeout)
+{
+    int bell = segment->doorbell;
+    oro_mb();
+    if ( shmAvailable() )
+        return true;
+    // announce that we will sleep and check again, such that either
+    // we see the new head or the sender sees our waiting flag.
+    segment->waiting = 1;
+    oro_mb();
+    if ( !shmAvailable() ) {
+        struct timespec ts;
+        ts.tv_sec = (time_t) timeout;
+        ts.tv_nsec = (long) ((timeout - ts.tv_sec) * 1000000000.0);
+        syscall(SYS_futex, &segment->doorbell, FUTEX_WAIT, bell, &ts, 0, 0);
+    }
+    segment->waiting = 0;
+    return shmAvailable();
+}
+
+bool SHMSendRecv::shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan)
+{
+    if (minit_done)
+        return true;
+
+    if (!mis_sender)
+    {
+        // Try to get the initial sample
+        //
+        // The output port implementation guarantees that there will be one
+        // after the connection is ready
+        if ( shmWait(0.5) && shmRead(ds) )
+        {
+            minit_done = true;
+            // ok, now we can start forwarding.
+            receiver = new Receiver(this, chan, "SHMReceiver");
+            receiver->start();
+            return true;
+        }
+        log(Error) << "Failed to receive initial data sample for SHM Channel Element." << endlog();
+        return false;
+    }
+    return false;
+}
+
+bool SHMSendRecv::shmRead(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    int tail = segment->tail;
+    if ( tail == segment->head )
+        return false;
+    // don't read the slot before we saw the head moving past it.
+    oro_mb();
+    char* s = slot(tail);
+    // the length comes from the other process, never read past the slot.
+    int length = *(int*) s;
+    bool result = false;
+    if ( length < 0 || length > segment->slot_size )
+        log(Error) << "SHMChannel: dropped a sample of invalid length " << length << endlog();
+    else
+        result = mtransport.updateFromBlob((void*) (s + sizeof(int)), length, ds, marshaller_cookie);
+    // don't let the sender reuse the slot before we copied it out.
+    oro_mb();
+    segment->tail = (tail + 1) % segment->slot_count;
+    return result;
+}
+
+bool SHMSendRecv::shmWrite(RTT::base::DataSourceBase::shared_ptr ds)
+{
+    int head = segment->head;
+    int next = (head + 1) % segment->slot_count;
+    if ( next == segment->tail )
+        return true; // full: drop the sample, like a non blocking mq_send.
+    oro_mb();
+
+    // let the marshaller write straight into the slot.
+    char* s = slot(head);
+    std::pair<void const*, int> blob = mtransport.fillBlob(ds, s + sizeof(int), segment->slot_size, marshaller_cookie);
+    if (blob.first == 0)
+    {
+        log(Error) << "SHMChannel: failed to marshal sample" << endlog();
+        return false;
+    }
+    if (blob.second < 0 || blob.second > segment->slot_size)
+    {
+        log(Error) << "SHMChannel: sample of " << blob.second << " bytes does not fit in a slot of "
+                   << segment->slot_size << " bytes" << endlog();
+        return false;
+    }
+    if (blob.first != s + sizeof(int))
+        memcpy(s + sizeof(int), blob.first, blob.second);
+    *(int*) s = blob.second;
+
+    // publish the slot, then ring the doorbell if the receiver sleeps.
+    oro_mb();
+    segment->head = next;
+    segment->doorbell = segment->doorbell + 1;
+    oro_mb();
+    if ( segment->waiting )
+        syscall(SYS_futex, &segment->doorbell, FUTEX_WAKE, 1, 0, 0, 0);
+    return true;
+}
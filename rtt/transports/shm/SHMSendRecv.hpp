@@ -0,0 +1,178 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  SHMSendRecv.hpp
+
+                        SHMSendRecv.hpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHMSENDRECV_HPP_
+#define ORO_SHMSENDRECV_HPP_
+
+#include "rtt-shm-config.h"
+#include "../../rtt-fwd.hpp"
+#include "../../base/DataSourceBase.hpp"
+#include <string>
+
+namespace RTT
+{
+    namespace shm
+    {
+        struct SHMSegment;
+
+        /**
+         * Implements the sending/receiving of samples through a POSIX
+         * shared memory segment. It can only be OR sender OR receiver
+         * (logical XOR).
+         *
+         * The segment holds a single producer, single consumer ring of
+         * fixed size slots. The marshaller writes each sample directly
+         * into its slot, so trivially copyable types are copied exactly
+         * once and are never serialized. The reader side blocks on a
+         * futex in the segment, which works across process boundaries
+         * and does not require a system call when the reader is busy.
+         */
+        class SHMSendRecv
+        {
+        protected:
+            class Receiver;
+
+            /**
+             * Transport marshaller used for size calculations
+             * and data updates.
+             */
+            types::TypeMarshaller const& mtransport;
+            /**
+             * A private blob that is returned by mtransport.getCookie(). It is
+             * used by the marshallers if they need private internal data to do
+             * the marshalling
+             */
+            void* marshaller_cookie;
+            /**
+             * Shared memory file descriptor.
+             */
+            int shmfd;
+            /**
+             * The mapped segment, or null if it is not mapped.
+             */
+            SHMSegment* segment;
+            /**
+             * The size of the mapping of \a segment.
+             */
+            size_t map_size;
+            /**
+             * The thread that waits for new samples on the receiving side.
+             */
+            Receiver* receiver;
+            /**
+             * True if this object is a sender.
+             */
+            bool mis_sender;
+            /**
+             * True if setupStream() was called, false after cleanupStream().
+             */
+            bool minit_done;
+            /**
+             * True if this object created the segment.
+             */
+            bool mis_creator;
+            /**
+             * The name of the segment, as specified in the ConnPolicy when
+             * creating the stream, or self-calculated when that name was empty.
+             */
+            std::string shmname;
+
+            /**
+             * Returns the address of the payload of slot \a i.
+             */
+            char* slot(int i) const;
+
+            /**
+             * Blocks at most \a timeout seconds until the ring contains
+             * a sample.
+             * @return true if a sample is available.
+             */
+            bool shmWait(double timeout);
+
+        public:
+            /**
+             * Create a channel element for remote data exchange.
+             * @param transport The type specific object that will be used to marshal the data.
+             */
+            SHMSendRecv(types::TypeMarshaller const& transport);
+
+            /**
+             * Creates or opens the shared memory segment of this stream.
+             * The side that creates the segment sizes its slots to the
+             * value provided by the ConnPolicy or, if the policy has a zero
+             * data size, to the sample given in \a ds. The other side
+             * adopts that layout.
+             * @throw std::runtime_error if the segment could not be set up.
+             */
+            void setupStream(base::DataSourceBase::shared_ptr ds, base::PortInterface* port, ConnPolicy const& policy, bool is_sender);
+
+            virtual ~SHMSendRecv();
+
+            void cleanupStream();
+
+            /**
+             * Works only in receive mode, waits for the initial sample and
+             * starts the thread that forwards samples to \a chan.
+             */
+            virtual bool shmReady(base::DataSourceBase::shared_ptr ds, base::ChannelElementBase* chan);
+
+            /**
+             * Returns true if the ring contains a sample that was not read yet.
+             */
+            bool shmAvailable() const;
+
+            /**
+             * Read from the shared memory segment.
+             * @param ds stores the resulting data sample.
+             * @return true if an item could be read.
+             */
+            bool shmRead(base::DataSourceBase::shared_ptr ds);
+
+            /**
+             * Write to the shared memory segment. When the ring is full,
+             * the sample is dropped, just like a full message queue does.
+             * @param ds the data sample to write
+             * @return true if it could be sent or was dropped, false if it
+             * could not be marshalled.
+             */
+            bool shmWrite(base::DataSourceBase::shared_ptr ds);
+        };
+    }
+}
+
+#endif /* ORO_SHMSENDRECV_HPP_ */
@@ -0,0 +1,17 @@
+#ifndef ORO_RTT_shm_FWD_HPP
+#define ORO_RTT_shm_FWD_HPP
+
+namespace RTT {
+    namespace shm {
+        class SHMSendRecv;
+        struct SHMSegment;
+        template<class T>
+        class SHMTemplateProtocol;
+        template<typename T>
+        class SHMChannelElement;
+    }
+    namespace detail {
+        using namespace shm;
+    }
+}
+#endif
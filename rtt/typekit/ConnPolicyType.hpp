@@ -59,6 +59,7 @@ namespace boost {
             a & boost::serialization::make_nvp("transport", c.transport );
             a & boost::serialization::make_nvp("data_size", c.data_size );
             a & boost::serialization::make_nvp("name_id", c.name_id );
+            a & boost::serialization::make_nvp("oneway", c.oneway );
         }
     }
 }
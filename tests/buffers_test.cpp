@@ -23,6 +23,7 @@
 
 #include <internal/AtomicQueue.hpp>
 #include <internal/AtomicMWSRQueue.hpp>
+#include <internal/ResizableMWSRQueue.hpp>
 
 #include <Activity.hpp>
 
@@ -125,6 +126,7 @@ public:
     BufferLockFree<Dummy>* lockfree;
     BufferLocked<Dummy>* locked;
     BufferUnSync<Dummy>* unsync;
+    BufferSPSC<Dummy>* spsc;
 
     BufferLockFree<Dummy>* clockfree;
     BufferLocked<Dummy>* clocked;
@@ -133,6 +135,7 @@ public:
     DataObjectLocked<Dummy>* dlocked;
     DataObjectLockFree<Dummy>* dlockfree;
     DataObjectUnSync<Dummy>* dunsync;
+    DataObjectSeqLock<Dummy>* dseqlock;
 
     ThreadInterface* athread;
     ThreadInterface* bthread;
@@ -147,6 +150,7 @@ public:
         lockfree = new BufferLockFree<Dummy>(QS);
         locked = new BufferLocked<Dummy>(QS);
         unsync = new BufferUnSync<Dummy>(QS);
+        spsc = new BufferSPSC<Dummy>(QS);
 
         // circular variants.
         clockfree = new BufferLockFree<Dummy>(QS,Dummy(), true);
@@ -156,6 +160,7 @@ public:
         dlockfree = new DataObjectLockFree<Dummy>();
         dlocked   = new DataObjectLocked<Dummy>();
         dunsync   = new DataObjectUnSync<Dummy>();
+        dseqlock  = new DataObjectSeqLock<Dummy>();
 
         // defaults
         buffer = lockfree;
@@ -166,12 +171,14 @@ public:
         delete lockfree;
         delete locked;
         delete unsync;
+        delete spsc;
         delete clockfree;
         delete clocked;
         delete cunsync;
         delete dlockfree;
         delete dlocked;
         delete dunsync;
+        delete dseqlock;
     }
 };
 
@@ -314,6 +321,20 @@ void BuffersDataFlowTest::testBuf()
     BOOST_CHECK( v[8] == *d );
     //BOOST_CHECK( v[9] == *c );
     BOOST_CHECK( 0 == buffer->Pop(v) );
+
+    // batched reads
+    BOOST_CHECK( buffer->Push( *c ) );
+    BOOST_CHECK( buffer->Push( *d ) );
+    BOOST_CHECK( buffer->Push( *c ) );
+    BOOST_CHECK_EQUAL( 2, buffer->Pop(v, 2) );
+    BOOST_REQUIRE_EQUAL( 2, (int)v.size() );
+    BOOST_CHECK( v[0] == *c );
+    BOOST_CHECK( v[1] == *d );
+    BOOST_CHECK_EQUAL( 1, buffer->Pop(v, sz) );
+    BOOST_REQUIRE_EQUAL( 1, (int)v.size() );
+    BOOST_CHECK( v[0] == *c );
+    BOOST_CHECK_EQUAL( 0, buffer->Pop(v, sz) );
+    BOOST_CHECK( v.empty() );
     delete d;
     delete c;
 }
@@ -694,6 +715,84 @@ struct AQEater : public RunnableInterface
     }
 };
 
+/**
+ * A plain old data sample of which all elements
+ * are written with the same value.
+ */
+struct SeqSample
+{
+    int v[32];
+};
+
+/**
+ * Writes increasing values in a DataObject.
+ */
+template<class T>
+struct DOWriter : public RunnableInterface
+{
+    volatile bool stop;
+    T* mdo;
+    int writes;
+    DOWriter(T* d ) : stop(false), mdo(d), writes(0) {}
+    bool initialize() {
+        stop = false;
+        return true;
+    }
+    void step() {
+        SeqSample s;
+        while (stop == false ) {
+            ++writes;
+            for (int i = 0; i != 32; ++i)
+                s.v[i] = writes;
+            mdo->Set( s );
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * Reads a DataObject and counts the torn or out of
+ * order samples.
+ */
+template<class T>
+struct DOReader : public RunnableInterface
+{
+    volatile bool stop;
+    T* mdo;
+    int reads, errors;
+    DOReader(T* d ) : stop(false), mdo(d), reads(0), errors(0) {}
+    bool initialize() {
+        stop = false;
+        return true;
+    }
+    void step() {
+        SeqSample s;
+        int last = 0;
+        while (stop == false ) {
+            mdo->Get( s );
+            ++reads;
+            for (int i = 1; i != 32; ++i)
+                if ( s.v[i] != s.v[0] )
+                    ++errors;
+            if ( s.v[0] < last )
+                ++errors;
+            last = s.v[0];
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
 
 BOOST_FIXTURE_TEST_SUITE( BuffersAtomicTestSuite, BuffersAQueueTest )
 
@@ -783,6 +882,91 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete d;
 }
 
+BOOST_AUTO_TEST_CASE( testAtomicMWSRQueueBatch )
+{
+    /**
+     * Single Threaded test for dequeueing batches.
+     */
+    Dummy items[QS];
+    Dummy* result[QS];
+
+    BOOST_CHECK_EQUAL( aqueue->dequeue( result, QS ), AtomicMWSRQueue<Dummy*>::size_type(0) );
+
+    // wrap the read and write pointers around once.
+    for ( int i = 0; i < QS/2 ; ++i) {
+        BOOST_CHECK( aqueue->enqueue( &items[i] ) );
+        BOOST_CHECK( aqueue->dequeue( result[0] ) );
+    }
+    for ( int i = 0; i < QS ; ++i)
+        BOOST_CHECK( aqueue->enqueue( &items[i] ) );
+    BOOST_CHECK( aqueue->isFull() );
+
+    BOOST_CHECK_EQUAL( aqueue->dequeue( result, 3 ), AtomicMWSRQueue<Dummy*>::size_type(3) );
+    for ( int i = 0; i < 3 ; ++i)
+        BOOST_CHECK_EQUAL( result[i], &items[i] );
+    BOOST_REQUIRE_EQUAL( AtomicMWSRQueue<Dummy*>::size_type(QS-3), aqueue->size() );
+
+    BOOST_CHECK_EQUAL( aqueue->dequeue( result, QS ), AtomicMWSRQueue<Dummy*>::size_type(QS-3) );
+    for ( int i = 0; i < QS - 3 ; ++i)
+        BOOST_CHECK_EQUAL( result[i], &items[i+3] );
+    BOOST_CHECK( aqueue->isEmpty() );
+    BOOST_CHECK_EQUAL( aqueue->dequeue( result, QS ), AtomicMWSRQueue<Dummy*>::size_type(0) );
+
+    // enqueue batches, wrapping the write pointer around again.
+    Dummy* values[QS];
+    for ( int i = 0; i < QS ; ++i)
+        values[i] = &items[i];
+    BOOST_CHECK_EQUAL( aqueue->enqueue( values, 2 ), AtomicMWSRQueue<Dummy*>::size_type(2) );
+    BOOST_CHECK_EQUAL( aqueue->enqueue( values + 2, QS ), AtomicMWSRQueue<Dummy*>::size_type(QS-2) );
+    BOOST_CHECK( aqueue->isFull() );
+    BOOST_CHECK_EQUAL( aqueue->enqueue( values, 1 ), AtomicMWSRQueue<Dummy*>::size_type(0) );
+    BOOST_CHECK_EQUAL( aqueue->dequeue( result, QS ), AtomicMWSRQueue<Dummy*>::size_type(QS) );
+    for ( int i = 0; i < QS ; ++i)
+        BOOST_CHECK_EQUAL( result[i], &items[i] );
+    BOOST_CHECK( aqueue->isEmpty() );
+}
+
+BOOST_AUTO_TEST_CASE( testResizableMWSRQueue )
+{
+    /**
+     * Single Threaded test for resizing a queue which holds items.
+     */
+    Dummy items[6];
+    Dummy* result[6];
+    Dummy* d = 0;
+    ResizableMWSRQueue<Dummy*> rqueue(2);
+
+    BOOST_CHECK( rqueue.enqueue( &items[0] ) );
+    BOOST_CHECK( rqueue.enqueue( &items[1] ) );
+    BOOST_CHECK( !rqueue.enqueue( &items[2] ) );
+
+    BOOST_CHECK( rqueue.resize(4) );
+    BOOST_CHECK_EQUAL( rqueue.capacity(), 4u );
+    for ( int i = 2; i != 6 ; ++i)
+        BOOST_CHECK( rqueue.enqueue( &items[i] ) );
+    BOOST_CHECK( rqueue.isFull() );
+    BOOST_CHECK_EQUAL( rqueue.size(), 6u );
+    // the first resize must be drained first.
+    BOOST_CHECK( !rqueue.resize(8) );
+
+    BOOST_CHECK( rqueue.dequeue( d ) );
+    BOOST_CHECK_EQUAL( d, &items[0] );
+    BOOST_CHECK_EQUAL( rqueue.dequeue( result, 6 ), 1u );
+    BOOST_CHECK_EQUAL( result[0], &items[1] );
+    BOOST_CHECK_EQUAL( rqueue.dequeue( result, 6 ), 4u );
+    for ( int i = 0; i != 4 ; ++i)
+        BOOST_CHECK_EQUAL( result[i], &items[i+2] );
+    BOOST_CHECK( rqueue.isEmpty() );
+
+    BOOST_CHECK( rqueue.resize(1) );
+    BOOST_CHECK( rqueue.enqueue( &items[0] ) );
+    BOOST_CHECK( !rqueue.enqueue( &items[1] ) );
+    BOOST_CHECK( rqueue.dequeue( d ) );
+    BOOST_CHECK_EQUAL( d, &items[0] );
+    BOOST_CHECK( !rqueue.dequeue( d ) );
+    BOOST_CHECK_EQUAL( rqueue.resizeCount(), 2 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE( BuffersDataFlowTestSuite, BuffersDataFlowTest )
@@ -811,6 +995,28 @@ BOOST_AUTO_TEST_CASE( testBufUnsync )
     testCirc();
 }
 
+BOOST_AUTO_TEST_CASE( testBufSPSC )
+{
+    buffer = spsc;
+    testBuf();
+
+    // a held sample is not overwritten and leaves the capacity intact.
+    Dummy c(2.0, 1.0, 0.0);
+    BOOST_CHECK( spsc->Push( c ) );
+    Dummy* held = spsc->PopWithoutRelease();
+    BOOST_REQUIRE( held );
+    BOOST_CHECK( *held == c );
+    std::vector<Dummy> v(QS, Dummy());
+    BOOST_CHECK_EQUAL( QS, spsc->Push( v ) );
+    BOOST_CHECK( spsc->full() );
+    BOOST_CHECK( spsc->Push( c ) == false );
+    BOOST_CHECK( *held == c );
+    spsc->Release( held );
+    BOOST_CHECK_EQUAL( QS, spsc->Pop( v ) );
+    BOOST_CHECK( v[0] == Dummy() );
+    BOOST_CHECK( spsc->empty() );
+}
+
 BOOST_AUTO_TEST_CASE( testDObjLockFree )
 {
     dataobj = dlockfree;
@@ -829,6 +1035,12 @@ BOOST_AUTO_TEST_CASE( testDObjUnSync )
     testDObj();
 }
 
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    dataobj = dseqlock;
+    testDObj();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_FIXTURE_TEST_SUITE( BuffersMPoolTestSuite, BuffersMPoolTest )
 
@@ -877,6 +1089,46 @@ BOOST_AUTO_TEST_CASE( testMemoryPool )
     BOOST_CHECK_EQUAL( mpool->size(), QS);
 }
 
+BOOST_AUTO_TEST_CASE( testLargeMemoryPool )
+{
+    // more than 65535 elements need 64bit indexes.
+    if ( sizeof(unsigned long) < 8 )
+        return;
+    const unsigned int sz = 100000;
+    TsPool<int> pool(sz);
+    BOOST_REQUIRE_EQUAL( sz, pool.capacity() );
+    BOOST_CHECK_EQUAL( sz, pool.size() );
+
+    std::vector<int*> ints(sz);
+    unsigned int failed = 0;
+    for (unsigned int i = 0; i != sz; ++i ) {
+        ints[i] = pool.allocate();
+        if ( ints[i] == 0 )
+            ++failed;
+    }
+    BOOST_CHECK_EQUAL( failed, 0u );
+    BOOST_CHECK_EQUAL( pool.size(), 0u );
+    BOOST_CHECK_EQUAL( pool.allocate(), (int*)0 );
+    for (unsigned int i = 0; i != sz; ++i )
+        pool.deallocate( ints[i] );
+    BOOST_CHECK_EQUAL( sz, pool.size() );
+
+    // a lock-free buffer of the same size.
+    BufferLockFree<int> buffer(sz);
+    for (unsigned int i = 0; i != sz; ++i )
+        if ( !buffer.Push( i ) )
+            ++failed;
+    BOOST_CHECK_EQUAL( failed, 0u );
+    BOOST_CHECK( buffer.full() );
+    BOOST_CHECK( buffer.Push( 0 ) == false );
+    int value = 0;
+    for (unsigned int i = 0; i != sz; ++i )
+        if ( !buffer.Pop( value ) || value != int(i) )
+            ++failed;
+    BOOST_CHECK_EQUAL( failed, 0u );
+    BOOST_CHECK( buffer.empty() );
+}
+
 #if 0
 BOOST_AUTO_TEST_CASE( testSortedList )
 {
@@ -1155,5 +1407,50 @@ BOOST_AUTO_TEST_CASE( testAtomicMWSRQueue )
     delete grower;
     delete eater;
 }
+
+BOOST_AUTO_TEST_CASE( testDataObjectSeqLock )
+{
+    SeqSample init;
+    for (int i = 0; i != 32; ++i)
+        init.v[i] = 0;
+    DataObjectSeqLock<SeqSample> dobj( init );
+    DOWriter< DataObjectSeqLock<SeqSample> > writer( &dobj );
+    DOReader< DataObjectSeqLock<SeqSample> > areader( &dobj );
+    DOReader< DataObjectSeqLock<SeqSample> > breader( &dobj );
+    DOReader< DataObjectSeqLock<SeqSample> > creader( &dobj );
+
+    {
+        boost::scoped_ptr<Activity> wthread( new Activity(20, &writer, "ActivityW" ));
+        boost::scoped_ptr<Activity> athread( new Activity(20, &areader, "ActivityA" ));
+        boost::scoped_ptr<Activity> bthread( new Activity(20, &breader, "ActivityB" ));
+        boost::scoped_ptr<Activity> cthread( new Activity(20, &creader, "ActivityC" ));
+
+        // avoid system lock-ups
+        wthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        athread->thread()->setScheduler(ORO_SCHED_OTHER);
+        bthread->thread()->setScheduler(ORO_SCHED_OTHER);
+        cthread->thread()->setScheduler(ORO_SCHED_OTHER);
+
+        log(Info) <<"Stressing single-write/multi-read..." <<endlog();
+        wthread->start();
+        athread->start();
+        bthread->start();
+        cthread->start();
+        sleep(3);
+        wthread->stop();
+        athread->stop();
+        bthread->stop();
+        cthread->stop();
+    }
+
+    cout << endl << "Total writes: " << writer.writes << endl;
+    cout << "Total reads : " << areader.reads + breader.reads + creader.reads << endl;
+    BOOST_CHECK( writer.writes > 0 );
+    BOOST_CHECK( areader.reads > 0 );
+    BOOST_CHECK_EQUAL( areader.errors + breader.errors + creader.errors, 0 );
+    SeqSample last = dobj.Get();
+    BOOST_CHECK_EQUAL( last.v[0], writer.writes );
+    BOOST_CHECK_EQUAL( last.v[31], writer.writes );
+}
 #endif
 BOOST_AUTO_TEST_SUITE_END()
@@ -411,6 +411,7 @@ BOOST_AUTO_TEST_CASE( testPortConnections )
     policy.lock_policy = RTT::corba::CLockFree;
     policy.size = 0;
     policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+    policy.oneway = false;
 
     corba::CDataFlowInterface_var ports  = s->ports();
     corba::CDataFlowInterface_var ports2 = s2->ports();
@@ -559,6 +560,7 @@ BOOST_AUTO_TEST_CASE( testDataHalfs )
     policy.lock_policy = RTT::corba::CLockFree;
     policy.size = 0;
     policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+    policy.oneway = false;
 
     corba::CDataFlowInterface_var ports  = s->ports();
     BOOST_REQUIRE( ports.in() );
@@ -624,6 +626,7 @@ BOOST_AUTO_TEST_CASE( testBufferHalfs )
     policy.lock_policy = RTT::corba::CLockFree;
     policy.size = 10;
     policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+    policy.oneway = false;
 
     corba::CDataFlowInterface_var ports  = s->ports();
     BOOST_REQUIRE( ports.in() );
@@ -261,6 +261,68 @@ BOOST_AUTO_TEST_CASE( testProperties )
     BOOST_CHECK_EQUAL( proxy_d.get(), 6.0);
 }
 
+BOOST_AUTO_TEST_CASE( testServiceDescriptions )
+{
+    ts = corba::TaskContextServer::Create( tc, false ); //no-naming
+    BOOST_CHECK( ts );
+    corba::CService_var serv = ts->server()->getProvider("this");
+
+    CORBA::ULong version = 0;
+    corba::CServiceDescriptions_var descs = serv->getServiceDescriptions( version );
+    BOOST_CHECK_EQUAL( version, serv->getInterfaceVersion() );
+    BOOST_REQUIRE( descs->length() >= 1 );
+    BOOST_CHECK_EQUAL( descs[0].parent, -1 );
+    BOOST_CHECK( !CORBA::is_nil( descs[0].service.in() ) );
+    for (CORBA::ULong i = 1; i < descs->length(); ++i)
+        BOOST_CHECK( descs[i].parent >= 0 && CORBA::ULong(descs[i].parent) < i );
+
+    // a changed interface changes the version:
+    tc->provides()->addConstant("cint2", 2);
+    BOOST_CHECK( version != serv->getInterfaceVersion() );
+
+    // the proxy is built from the description:
+    tp = corba::TaskContextProxy::Create( ts->server(), true );
+    BOOST_CHECK( tp );
+    BOOST_CHECK( tp->provides()->hasAttribute("cint2") );
+    BOOST_CHECK( findProperty( *tp->provides()->properties(), "s1.s2.pdouble1") );
+    BOOST_REQUIRE( tp->provides()->hasService("methods") );
+    BOOST_REQUIRE( tp->provides("methods")->getPart("m1") );
+    BOOST_CHECK_EQUAL( tp->provides("methods")->getPart("m1")->arity(), 1u );
+    BOOST_CHECK_EQUAL( tp->provides("methods")->getPart("m1")->resultType(), "double" );
+}
+
+BOOST_AUTO_TEST_CASE( testCachedProperties )
+{
+    ts = corba::TaskContextServer::Create( tc, false ); //no-naming
+    BOOST_CHECK( ts );
+    corba::TaskContextProxy::SetCacheStaleness( 60.0 );
+    tp = corba::TaskContextProxy::Create( ts->server(), true );
+    corba::TaskContextProxy::SetCacheStaleness( 0.0 );
+    BOOST_CHECK( tp );
+
+    Property<int> proxy_int = findProperty( *tp->provides()->properties(), "pint1");
+    BOOST_REQUIRE( proxy_int.ready() );
+    Attribute<double> proxy_double = tp->provides()->getAttribute("adouble1");
+    BOOST_REQUIRE( proxy_double.ready() );
+
+    // first read fills the cache:
+    BOOST_CHECK_EQUAL( proxy_int.get(), 3);
+    BOOST_CHECK_EQUAL( proxy_double.get(), -3.0);
+    // remote changes are not seen while the cache is fresh:
+    pint1 = 4;
+    adouble1 = 4.0;
+    BOOST_CHECK_EQUAL( proxy_int.get(), 3);
+    BOOST_CHECK_EQUAL( proxy_double.get(), -3.0);
+    // a local set invalidates the cache:
+    proxy_int.set( 5 );
+    BOOST_CHECK_EQUAL( pint1, 5);
+    BOOST_CHECK_EQUAL( proxy_double.get(), 4.0);
+    // disabling the cache reads through again:
+    static_cast<corba::TaskContextProxy*>(tp)->setCacheStaleness( 0.0 );
+    adouble1 = 6.0;
+    BOOST_CHECK_EQUAL( proxy_double.get(), 6.0);
+}
+
 BOOST_AUTO_TEST_CASE( testOperationCallerC_Call )
 {
 
@@ -360,6 +422,31 @@ BOOST_AUTO_TEST_CASE( testOperationCallerC_Send )
     BOOST_REQUIRE( tc->inException() );
 }
 
+BOOST_AUTO_TEST_CASE( testOperationCallerC_SendPipelined )
+{
+    ts = corba::TaskContextServer::Create( tc, false ); //no-naming
+    BOOST_CHECK( ts );
+    tp = corba::TaskContextProxy::Create( ts->server(), true );
+    BOOST_CHECK( tp );
+
+    // many sends are in flight before the first collect:
+    const int n = 10;
+    OperationCallerC mc[n];
+    SendHandleC shc[n];
+    double cr[n];
+    for (int i = 0; i != n; ++i) {
+        cr[i] = 0.0;
+        mc[i] = tp->provides("methods")->create("m1cr", caller->engine()).argC( double(i) );
+        shc[i] = mc[i].send();
+        shc[i].arg(cr[i]);
+        BOOST_CHECK_NO_THROW( shc[i].check() );
+    }
+    for (int i = 0; i != n; ++i) {
+        BOOST_CHECK_EQUAL( shc[i].collect(), SendSuccess);
+        BOOST_CHECK_EQUAL( cr[i], double(i) );
+    }
+}
+
 BOOST_AUTO_TEST_CASE( testRemoteOperationCallerCall )
 {
 
@@ -494,6 +581,7 @@ BOOST_AUTO_TEST_CASE( testPortConnections )
     policy.lock_policy = RTT::corba::CLockFree;
     policy.size = 0;
     policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+    policy.oneway = false;
 
     corba::CDataFlowInterface_var ports  = ts->server()->ports();
     corba::CDataFlowInterface_var ports2 = ts2->server()->ports();
@@ -526,6 +614,16 @@ BOOST_AUTO_TEST_CASE( testPortConnections )
     ports2->disconnectPort("mi");
     testPortDisconnected();
 
+    // pushed data without waiting for the reader's side.
+    policy.type = RTT::corba::CData;
+    policy.pull = false;
+    policy.oneway = true;
+    BOOST_CHECK( ports->createConnection("mo", ports2, "mi", policy) );
+    testPortDataConnection();
+    ports->disconnectPort("mo");
+    testPortDisconnected();
+    policy.oneway = false;
+
     policy.type = RTT::corba::CBuffer;
     policy.pull = false;
     policy.size = 3;
@@ -613,6 +711,7 @@ BOOST_AUTO_TEST_CASE( testDataHalfs )
     policy.lock_policy = RTT::corba::CLockFree;
     policy.size = 0;
     policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+    policy.oneway = false;
 
     corba::CDataFlowInterface_var ports  = ts->server()->ports();
     BOOST_REQUIRE( ports.in() );
@@ -670,6 +769,7 @@ BOOST_AUTO_TEST_CASE( testBufferHalfs )
     policy.lock_policy = RTT::corba::CLockFree;
     policy.size = 10;
     policy.transport = ORO_CORBA_PROTOCOL_ID; // force creation of non-local connections
+    policy.oneway = false;
 
     corba::CDataFlowInterface_var ports  = ts->server()->ports();
     BOOST_REQUIRE( ports.in() );
@@ -22,6 +22,7 @@
 #include "logger_test.hpp"
 
 #include <iostream>
+#include <sstream>
 #include <boost/scoped_ptr.hpp>
 #include <Activity.hpp>
 #include <base/RunnableInterface.hpp>
@@ -118,4 +119,43 @@ BOOST_AUTO_TEST_CASE( testThreadLog )
 
 }
 
+BOOST_AUTO_TEST_CASE( testAsyncLog )
+{
+    std::stringstream out;
+    logger->setStdStream( out );
+    // a flusher needs a period.
+    BOOST_CHECK( !logger->startAsync(0) );
+    BOOST_CHECK( !logger->isAsync() );
+    BOOST_REQUIRE( logger->startAsync(0.01) );
+    BOOST_CHECK( logger->isAsync() );
+
+    {
+        Logger::In in("AsyncLog");
+        log(Error) << "Asynchronous message " << 42 << endlog();
+        log(Error) << std::string(1000, 'x') << endlog(); // truncated
+        log(Debug) << "Filtered message" << endlog();
+    }
+
+    // the other threads log through their own rings.
+    boost::scoped_ptr<TestLog> run( new TestLog() );
+    boost::scoped_ptr<ActivityInterface> t( new Activity(25, 0.001, 0, "ORActivity1") );
+    t->run( run.get() );
+    t->start();
+    usleep(200000);
+    t->stop();
+
+    logger->stopAsync();
+    BOOST_CHECK( !logger->isAsync() );
+    logger->setStdStream( std::cerr );
+
+    std::string result = out.str();
+    if ( logger->getLogLevel() >= Logger::Error ) {
+        BOOST_CHECK( result.find("[AsyncLog] Asynchronous message 42") != std::string::npos );
+        BOOST_CHECK( result.find(std::string(1000, 'x')) == std::string::npos );
+    }
+    if ( logger->getLogLevel() < Logger::Debug )
+        BOOST_CHECK( result.find("Filtered message") == std::string::npos );
+    log(Info) << "Dropped " << logger->getDroppedMessages() << " asynchronous messages." << endlog();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -39,6 +39,7 @@ public:
     void testLogEnv();
     void testNewLog();
     void testThreadLog();
+    void testAsyncLog();
 };
 
 #endif
@@ -24,6 +24,7 @@
 #include <transports/mqueue/MQLib.hpp>
 #include <transports/mqueue/MQChannelElement.hpp>
 #include <transports/mqueue/MQTemplateProtocol.hpp>
+#include <transports/mqueue/Dispatcher.hpp>
 #include <os/fosi.h>
 
 using namespace std;
@@ -285,6 +286,37 @@ BOOST_AUTO_TEST_CASE( testPortStreams )
     testPortDisconnected();
 }
 
+BOOST_AUTO_TEST_CASE( testPortStreamsSharded )
+{
+    // Spread the queues over several dispatcher threads.
+    BOOST_REQUIRE( mqueue::Dispatcher::setShards(4) );
+
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/data1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    // can not change the pool while it is in use.
+    BOOST_CHECK( mqueue::Dispatcher::setShards(2) == false );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 3;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    BOOST_CHECK( mqueue::Dispatcher::setShards(1) );
+}
+
 BOOST_AUTO_TEST_CASE( testPortStreamsTimeout )
 {
     // Test creating an input stream without an output stream available.
@@ -25,6 +25,8 @@
 #include <extras/SequentialActivity.hpp>
 #include <extras/SimulationActivity.hpp>
 #include <extras/SimulationThread.hpp>
+#include <Activity.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
@@ -54,6 +56,34 @@ public:
 /**
  * Fixture.
  */
+/**
+ * Writes a port as fast as possible, while the test
+ * connects and disconnects readers.
+ */
+struct PortWriter : public RunnableInterface
+{
+    volatile bool stop;
+    OutputPort<int>* port;
+    int writes;
+    PortWriter(OutputPort<int>* p) : stop(false), port(p), writes(0) {}
+    bool initialize() {
+        stop = false; writes = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false ) {
+            port->write( ++writes );
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
 class PortsTestFixture
 {
 public:
@@ -345,6 +375,172 @@ BOOST_AUTO_TEST_CASE(testPortOneWriterThreeReaders)
     BOOST_CHECK_EQUAL( rp3.read(value), NoData );
 }
 
+BOOST_AUTO_TEST_CASE(testPortSharedDataReaders)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2");
+    InputPort<int> rp3("R3");
+
+    wp.write(5);
+    BOOST_CHECK( wp.createConnection(rp1, ConnPolicy::sharedData(3)) );
+    BOOST_CHECK( wp.createConnection(rp2, ConnPolicy::sharedData(3, ConnPolicy::LOCK_FREE, false)) );
+    BOOST_CHECK( rp1.connected() );
+    BOOST_CHECK( rp2.connected() );
+
+    // only rp1 asked for initialization.
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( 5, value );
+    BOOST_CHECK_EQUAL( rp2.read(value), NoData );
+
+    wp.write(10);
+    wp.write(20);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( 20, value );
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL( 20, value );
+
+    // a late reader gets the last value, without new data for the others.
+    BOOST_CHECK( wp.createConnection(rp3, ConnPolicy::sharedData(3)) );
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL( 20, value );
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( rp2.read(value), OldData );
+
+    rp2.clear();
+    BOOST_CHECK_EQUAL( rp2.read(value), NoData );
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+
+    wp.write(30);
+    wp.disconnect(&rp1);
+    BOOST_CHECK_EQUAL( rp1.read(value), NoData );
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL( 30, value );
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL( 30, value );
+
+    // shared and unshared connections can be mixed.
+    BOOST_CHECK( wp.createConnection(rp1, ConnPolicy::buffer(4)) );
+    wp.write(40);
+    wp.write(50);
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( 40, value );
+    BOOST_CHECK_EQUAL( rp3.read(value), NewData );
+    BOOST_CHECK_EQUAL( 50, value );
+    BOOST_CHECK_EQUAL( rp3.read(value), OldData );
+
+    wp.disconnect();
+    BOOST_CHECK( !rp2.connected() );
+    BOOST_CHECK( !rp3.connected() );
+}
+
+BOOST_AUTO_TEST_CASE(testPortSharedDataLimits)
+{
+    OutputPort<int> wp("W");
+    std::vector< boost::shared_ptr< InputPort<int> > > rps;
+    for (int i = 0; i != 9; ++i)
+        rps.push_back( boost::shared_ptr< InputPort<int> >( new InputPort<int>("R") ) );
+
+    // the storage supports at least 8 readers.
+    for (int i = 0; i != 8; ++i)
+        BOOST_CHECK( wp.createConnection(*rps[i], ConnPolicy::sharedData(1)) );
+    BOOST_CHECK( !wp.createConnection(*rps[8], ConnPolicy::sharedData(1)) );
+    BOOST_CHECK( !rps[8]->connected() );
+
+    // a disconnected reader is released.
+    wp.disconnect( rps[0].get() );
+    BOOST_CHECK( !wp.createConnection(*rps[8], ConnPolicy::sharedData(1, ConnPolicy::LOCKED)) );
+    BOOST_CHECK( wp.createConnection(*rps[8], ConnPolicy::sharedData(1)) );
+
+    wp.write(1);
+    int value = 0;
+    BOOST_CHECK_EQUAL( rps[8]->read(value), NewData );
+    BOOST_CHECK_EQUAL( 1, value );
+    wp.disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(testPortConnectWhileWriting)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1", ConnPolicy::data());
+    InputPort<int> rp2("R2", ConnPolicy::buffer(8));
+    PortWriter writer(&wp);
+    boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, &writer, "PortWriter") );
+
+    BOOST_REQUIRE( wp.createConnection(rp1) );
+    BOOST_REQUIRE( athread->start() );
+    int value = 0;
+    int last = 0;
+    for (int i = 0; i != 200; ++i) {
+        BOOST_REQUIRE( wp.createConnection(rp2) );
+        // the reader keeps its current channel while the others come and go.
+        if ( rp1.read(value) == NewData ) {
+            BOOST_CHECK( value > last );
+            last = value;
+        }
+        rp2.read(value);
+        wp.disconnect(&rp2);
+        BOOST_CHECK( !rp2.connected() );
+    }
+    athread->stop();
+    BOOST_CHECK( writer.writes > 0 );
+    BOOST_CHECK( wp.connected() );
+    wp.write( writer.writes + 1 );
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( value, writer.writes + 1 );
+}
+
+BOOST_AUTO_TEST_CASE(testPortBatchReadWrite)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1");
+    InputPort<int> rp2("R2");
+
+    BOOST_CHECK( wp.createConnection(rp1, ConnPolicy::buffer(4)) );
+    BOOST_CHECK( wp.createConnection(rp2, ConnPolicy::data()) );
+
+    std::vector<int> samples;
+    BOOST_CHECK_EQUAL( 0, rp1.readAll(samples) );
+    BOOST_CHECK( samples.empty() );
+
+    // the buffer keeps what fits, the data connection the last sample.
+    std::vector<int> batch;
+    for (int i = 1; i <= 6; ++i)
+        batch.push_back(i);
+    wp.writeBatch(batch);
+    BOOST_CHECK_EQUAL( 2, rp1.readBatch(samples, 2) );
+    BOOST_REQUIRE_EQUAL( 2, (int)samples.size() );
+    BOOST_CHECK_EQUAL( 1, samples[0] );
+    BOOST_CHECK_EQUAL( 2, samples[1] );
+    BOOST_CHECK_EQUAL( 2, rp1.readAll(samples) );
+    BOOST_REQUIRE_EQUAL( 2, (int)samples.size() );
+    BOOST_CHECK_EQUAL( 3, samples[0] );
+    BOOST_CHECK_EQUAL( 4, samples[1] );
+    BOOST_CHECK_EQUAL( 0, rp1.readAll(samples) );
+
+    // the last sample of a batch read is old data afterwards.
+    int value = 0;
+    BOOST_CHECK_EQUAL( rp1.read(value), OldData );
+    BOOST_CHECK_EQUAL( 4, value );
+
+    BOOST_CHECK_EQUAL( 1, rp2.readAll(samples) );
+    BOOST_REQUIRE_EQUAL( 1, (int)samples.size() );
+    BOOST_CHECK_EQUAL( 6, samples[0] );
+    BOOST_CHECK_EQUAL( 0, rp2.readAll(samples) );
+    BOOST_CHECK_EQUAL( rp2.read(value), OldData );
+    BOOST_CHECK_EQUAL( 6, value );
+
+    // single writes and batched reads mix.
+    wp.write(7);
+    wp.write(8);
+    BOOST_CHECK_EQUAL( 2, rp1.readAll(samples) );
+    BOOST_CHECK_EQUAL( 7, samples[0] );
+    BOOST_CHECK_EQUAL( 8, samples[1] );
+    BOOST_CHECK_EQUAL( 8, wp.getLastWrittenValue() );
+}
+
 BOOST_AUTO_TEST_CASE(testPortThreeWritersOneReader)
 {
     OutputPort<int> wp1("W1");
@@ -431,7 +627,12 @@ BOOST_AUTO_TEST_CASE(testPortThreeWritersOneReader)
 
     // And finally the other ports as well
     rp.disconnect(&wp1);
+    // wp1's channel was the current one, wp3's takes over.
+    rp.getDataSample(value);
     rp.disconnect(&wp3);
+    value = 1;
+    rp.getDataSample(value);
+    BOOST_CHECK_EQUAL(1, value);
     BOOST_CHECK( !rp.connected() );
     BOOST_CHECK( !wp1.connected() );
     BOOST_CHECK( !wp2.connected() );
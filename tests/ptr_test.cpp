@@ -20,6 +20,8 @@
 #include "unit.hpp"
 
 #include "ptr_test.hpp"
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
 
 using namespace std;
 
@@ -107,4 +109,59 @@ BOOST_AUTO_TEST_CASE( testPromotion )
     delete write;
 }
 
+BOOST_AUTO_TEST_CASE( testLoanPool )
+{
+    typedef std::vector<double> Sample;
+    LoanPool<Sample> pool(2, Sample(10, 0.0));
+    BOOST_CHECK_EQUAL( pool.capacity(), 2u );
+
+    LoanedPointer<Sample> ptr1 = pool.loan();
+    BOOST_REQUIRE( ptr1.valid() );
+    BOOST_CHECK( ptr1.unique() );
+    BOOST_REQUIRE( ptr1.write_access() );
+    BOOST_CHECK_EQUAL( ptr1->size(), 10u );
+    (*ptr1.write_access())[0] = 1.0;
+    BOOST_CHECK_EQUAL( pool.available(), 1u );
+
+    LoanedPointer<Sample> ptr2 = pool.loan();
+    BOOST_CHECK( ptr2.valid() );
+    BOOST_CHECK( !pool.loan().valid() );
+
+    {
+        // shared samples are read-only.
+        LoanedPointer<Sample> copy( ptr1 );
+        BOOST_CHECK( copy.get() == ptr1.get() );
+        BOOST_CHECK( !ptr1.unique() );
+        BOOST_CHECK( ptr1.write_access() == 0 );
+        BOOST_CHECK_EQUAL( (*copy)[0], 1.0 );
+    }
+    BOOST_CHECK( ptr1.unique() );
+    ptr1.reset();
+    BOOST_CHECK( !ptr1.valid() );
+    BOOST_CHECK_EQUAL( pool.available(), 1u );
+
+    // samples travel through a connection without being copied.
+    OutputPort< LoanedPointer<Sample> > out("out");
+    InputPort< LoanedPointer<Sample> > in("in");
+    BOOST_REQUIRE( out.connectTo( &in ) );
+    const Sample* sent = ptr2.get();
+    out.write( ptr2 );
+    ptr2.reset();
+    LoanedPointer<Sample> received;
+    BOOST_CHECK_EQUAL( in.read( received ), NewData );
+    BOOST_CHECK( received.get() == sent );
+    BOOST_CHECK( !received.unique() );
+    in.disconnect();
+    out.keepLastWrittenValue( false );
+
+    // a loaned sample outlives its pool.
+    LoanedPointer<Sample> kept;
+    {
+        LoanPool<Sample> small(1, Sample(3, 2.0));
+        kept = small.loan();
+    }
+    BOOST_REQUIRE( kept.valid() );
+    BOOST_CHECK_EQUAL( (*kept)[2], 2.0 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,7 @@
 #define BUFFERSTEST_H
 
 #include <extras/ReadOnlyPointer.hpp>
+#include <extras/LoanPool.hpp>
 
 class PtrTest
 {
@@ -28,6 +29,7 @@ public:
 
     void testReadOnly();
     void testPromotion();
+    void testLoanPool();
 };
 
 #endif
@@ -0,0 +1,377 @@
+/***************************************************************************
+  tag: The SourceWorks  Sun Oct 18 2026  shm_test.cpp
+
+                        shm_test.cpp -  description
+                           -------------------
+    begin                : Sun October 18 2026
+    copyright            : (C) 2026 The SourceWorks
+    email                : peter@thesourceworks.com
+
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "unit.hpp"
+
+#include <iostream>
+
+#include <Service.hpp>
+#include <transports/shm/SHMLib.hpp>
+#include <transports/shm/SHMChannelElement.hpp>
+#include <transports/shm/SHMTemplateProtocol.hpp>
+#include <os/fosi.h>
+
+using namespace std;
+using namespace RTT;
+using namespace RTT::detail;
+
+#include <InputPort.hpp>
+#include <OutputPort.hpp>
+#include <TaskContext.hpp>
+#include <string>
+
+using namespace RTT;
+using namespace RTT::detail;
+
+class SHMTest
+{
+public:
+    SHMTest()
+    {
+        // connect DataPorts
+        mr1 = new InputPort<double>("mr");
+        mw1 = new OutputPort<double>("mw");
+
+        mr2 = new InputPort<double>("mr");
+        mw2 = new OutputPort<double>("mw");
+
+        // both tc's are non periodic
+        tc =  new TaskContext( "root" );
+        tc->ports()->addEventPort( *mr1 );
+        tc->ports()->addPort( *mw1 );
+
+        t2 = new TaskContext("other");
+        t2->ports()->addEventPort( *mr2, boost::bind(&SHMTest::new_data_listener, this, _1) );
+        t2->ports()->addPort( *mw2 );
+
+        tc->start();
+        t2->start();
+    }
+
+    ~SHMTest()
+    {
+        delete tc;
+        delete t2;
+
+        delete mr1;
+        delete mw1;
+        delete mr2;
+        delete mw2;
+    }
+
+    TaskContext* tc;
+    TaskContext* t2;
+
+    PortInterface* signalled_port;
+    void new_data_listener(PortInterface* port)
+    {
+        signalled_port = port;
+    }
+
+    // Ports
+    InputPort<double>*  mr1;
+    OutputPort<double>* mw1;
+    InputPort<double>*  mr2;
+    OutputPort<double>* mw2;
+
+    ConnPolicy policy;
+
+    // helper test functions
+    void testPortDataConnection();
+    void testPortBufferConnection();
+    void testPortDisconnected();
+};
+
+class SHMFixture : public SHMTest
+{
+public:
+    SHMFixture() {
+        // Create a default policy specification
+        policy.type = ConnPolicy::DATA;
+        policy.init = false;
+        policy.lock_policy = ConnPolicy::LOCK_FREE;
+        policy.size = 0;
+        policy.pull = true;
+        policy.transport = ORO_SHM_PROTOCOL_ID;
+    }
+};
+
+#define ASSERT_PORT_SIGNALLING(code, read_port) \
+    signalled_port = 0; \
+    code; \
+    rtos_disable_rt_warning(); \
+    usleep(100000); \
+    rtos_enable_rt_warning(); \
+    BOOST_CHECK( read_port == signalled_port );
+
+void SHMTest::testPortDataConnection()
+{
+    rtos_enable_rt_warning();
+    // This test assumes that there is a data connection mw1 => mr2
+    // Check if connection succeeded both ways:
+    BOOST_CHECK( mw1->connected() );
+    BOOST_CHECK( mr2->connected() );
+
+    double value = 0;
+
+    // Check if no-data works
+    BOOST_CHECK( NoData == mr2->read(value) );
+
+    // Check if writing works (including signalling)
+    ASSERT_PORT_SIGNALLING(mw1->write(1.0), mr2)
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 1.0, value );
+    ASSERT_PORT_SIGNALLING(mw1->write(2.0), mr2);
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 2.0, value );
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    rtos_disable_rt_warning();
+}
+
+void SHMTest::testPortBufferConnection()
+{
+    rtos_enable_rt_warning();
+    // This test assumes that there is a buffer connection mw1 => mr2 of size 3
+    // Check if connection succeeded both ways:
+    BOOST_CHECK( mw1->connected() );
+    BOOST_CHECK( mr2->connected() );
+
+    double value = 0;
+
+    // Check if no-data works
+    BOOST_CHECK( NoData == mr2->read(value) );
+
+    // Check if writing works
+    ASSERT_PORT_SIGNALLING(mw1->write(1.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(2.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(3.0), mr2);
+    ASSERT_PORT_SIGNALLING(mw1->write(4.0), 0);  // because size == 3
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 1.0, value );
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 2.0, value );
+    BOOST_CHECK( mr2->read(value) );
+    BOOST_CHECK_EQUAL( 3.0, value );
+    BOOST_CHECK( OldData == mr2->read(value) );
+
+    rtos_disable_rt_warning();
+}
+
+void SHMTest::testPortDisconnected()
+{
+    BOOST_CHECK( !mw1->connected() );
+    BOOST_CHECK( !mr2->connected() );
+}
+
+
+// Registers the fixture into the 'registry'
+BOOST_FIXTURE_TEST_SUITE(  SHMTestSuite,  SHMFixture )
+
+/**
+ * This unit test checks a manual setup of shared memory data flow,
+ * without any use of CORBA to mediate the connection.
+ */
+BOOST_AUTO_TEST_CASE( testPortConnections )
+{
+#if 1
+    // WARNING: in the following, there is four configuration tested.
+    // We need to manually disconnect both sides since segments are connection-less.
+    policy.type = ConnPolicy::DATA;
+    policy.pull = true;
+    // test user supplied connection.
+    policy.name_id = "/data1";
+    BOOST_REQUIRE( mw1->createConnection(*mr2, policy) );
+    BOOST_CHECK( policy.name_id == "/data1" );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::DATA;
+    policy.pull = true;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createConnection(*mr2, policy) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+#endif
+#if 1
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 3;
+    policy.name_id = "";
+    //policy.name_id = "buffer1";
+    BOOST_REQUIRE( mw1->createConnection(*mr2, policy) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+#endif
+#if 1
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = true;
+    policy.size = 3;
+    policy.name_id = "";
+    //policy.name_id = "buffer2";
+    BOOST_REQUIRE( mw1->createConnection(*mr2, policy) );
+    testPortBufferConnection();
+    //while(1) sleep(1);
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+#endif
+    }
+
+BOOST_AUTO_TEST_CASE( testPortStreams )
+{
+    // Test all four configurations of Data/Buffer & push/pull
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/data1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::DATA;
+    policy.pull = true;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortDataConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 3;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = true;
+    policy.size = 3;
+    policy.name_id = "";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+    testPortBufferConnection();
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsTimeout )
+{
+    // Test creating an input stream without an output stream available.
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/data1";
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.name_id = "/buffer1";
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+}
+
+
+BOOST_AUTO_TEST_CASE( testPortStreamsWrongName )
+{
+    // Test creating an input/output stream with a wrong name
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "data1"; // name must start with '/'
+    BOOST_REQUIRE( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mr2->disconnect();
+
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 10;
+    policy.name_id = "buffer1";
+    BOOST_REQUIRE( mw2->createStream( policy ) == false );
+    BOOST_CHECK( mw2->connected() == false );
+    mw2->disconnect();
+}
+
+BOOST_AUTO_TEST_CASE( testPortStreamsSlotSize )
+{
+    // A side that needs larger samples than the segment holds is refused.
+    policy.type = ConnPolicy::DATA;
+    policy.pull = false;
+    policy.name_id = "/small1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    policy.data_size = 1024;
+    BOOST_CHECK( mr2->createStream( policy ) == false );
+    BOOST_CHECK( mr2->connected() == false );
+    mw1->disconnect();
+    mr2->disconnect();
+}
+
+BOOST_AUTO_TEST_CASE( testPortBurst )
+{
+    // Push more samples than the ring holds through a buffer connection
+    // and check that the receiver gets them in order, without gaps.
+    policy.type = ConnPolicy::BUFFER;
+    policy.pull = false;
+    policy.size = 100;
+    policy.name_id = "/burst1";
+    BOOST_REQUIRE( mw1->createStream( policy ) );
+    BOOST_REQUIRE( mr2->createStream( policy ) );
+
+    double value = 0, expected = 0;
+    int received = 0;
+    for (int i = 1; i <= 1000; ++i) {
+        mw1->write( double(i) );
+        if ( i % 50 == 0 )
+            usleep(20000);
+        while ( mr2->read(value) == NewData ) {
+            BOOST_CHECK_EQUAL( value, expected + 1 );
+            expected = value;
+            ++received;
+        }
+    }
+    usleep(100000);
+    while ( mr2->read(value) == NewData ) {
+        BOOST_CHECK_EQUAL( value, expected + 1 );
+        expected = value;
+        ++received;
+    }
+    BOOST_CHECK_EQUAL( received, 1000 );
+
+    mw1->disconnect();
+    mr2->disconnect();
+    testPortDisconnected();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -11,7 +11,11 @@
 #include "specialized_activities.hpp"
 #include <extras/FileDescriptorActivity.hpp>
 #include <iostream>
+#include <cstdio>
 #include <rtt-detail-fwd.hpp>
+#if defined(OROPKG_OS_GNULINUX)
+#include <sys/resource.h>
+#endif
 using namespace RTT::detail;
 
 using namespace std;
@@ -19,12 +23,12 @@ using namespace RTT;
 
 struct TestFDActivity : public FileDescriptorActivity
 {
-    int step_count, count, other_count;
+    int step_count, count, other_count, timeout_count;
     int fd, other_fd, result;
 
     bool do_read;
     TestFDActivity()
-        : FileDescriptorActivity(0), step_count(0), count(0), other_count(0), do_read(false) {}
+        : FileDescriptorActivity(0), step_count(0), count(0), other_count(0), timeout_count(0), do_read(false) {}
 
     void step()
     {
@@ -41,6 +45,8 @@ struct TestFDActivity : public FileDescriptorActivity
             if (do_read)
                 result = read(other_fd, &buffer, 1);
         }
+        if (hasTimeout())
+            ++timeout_count;
         ++step_count;
     };
 };
@@ -121,6 +127,75 @@ BOOST_AUTO_TEST_CASE( testFileDescriptorActivity )
     BOOST_CHECK_EQUAL(2, activity->other_count);
 }
 
+#if defined(OROPKG_OS_GNULINUX)
+BOOST_AUTO_TEST_CASE( testFileDescriptorActivityEpoll )
+{
+    // Watch a FD above FD_SETSIZE, which select() could not handle
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max <= FD_SETSIZE + 16)
+    {
+        BOOST_TEST_MESSAGE("RLIMIT_NOFILE too low, skipping testFileDescriptorActivityEpoll");
+        return;
+    }
+    if (limit.rlim_cur != RLIM_INFINITY && limit.rlim_cur <= FD_SETSIZE + 16)
+    {
+        limit.rlim_cur = FD_SETSIZE + 16;
+        BOOST_REQUIRE( setrlimit(RLIMIT_NOFILE, &limit) == 0 );
+    }
+
+    auto_ptr<TestFDActivity> activity(new TestFDActivity);
+    static const int USLEEP = 250000;
+
+    int pipe_fds[2];
+    BOOST_REQUIRE( pipe(pipe_fds) == 0 );
+    int reader = FD_SETSIZE + 8;
+    BOOST_REQUIRE( dup2(pipe_fds[0], reader) == reader );
+    close(pipe_fds[0]);
+    int writer = pipe_fds[1];
+
+    activity->fd = reader;
+    activity->other_fd = -1;
+    activity->do_read = true;
+    activity->watch(reader);
+    BOOST_CHECK( activity->isWatched(reader) );
+    BOOST_CHECK( activity->start() );
+
+    char buffer = 0;
+    BOOST_CHECK( write(writer, &buffer, 1) == 1 );
+    usleep(USLEEP);
+    BOOST_CHECK_EQUAL(1, activity->step_count);
+    BOOST_CHECK_EQUAL(1, activity->count);
+    BOOST_CHECK( activity->stop() );
+
+    // Sub-millisecond timeouts
+    activity->do_read = false;
+    activity->setTimeoutNSecs(2500000);
+    BOOST_CHECK_EQUAL(2500000, activity->getTimeoutNSecs());
+    BOOST_CHECK_EQUAL(2, activity->getTimeout());
+    BOOST_CHECK( activity->start() );
+    usleep(USLEEP);
+    BOOST_CHECK( activity->stop() );
+    BOOST_CHECK( activity->step_count >= 20 );
+    BOOST_CHECK_EQUAL(1, activity->count);
+    BOOST_CHECK_EQUAL(activity->step_count - 1, activity->timeout_count);
+
+    // epoll refuses regular files, they are not watched
+    FILE* file = tmpfile();
+    BOOST_REQUIRE( file );
+    activity->watch(fileno(file));
+    BOOST_CHECK( activity->isWatched(fileno(file)) );
+    BOOST_CHECK( activity->start() );
+    BOOST_CHECK( !activity->isWatched(fileno(file)) );
+    activity->watch(fileno(file));
+    BOOST_CHECK( !activity->isWatched(fileno(file)) );
+    BOOST_CHECK( activity->stop() );
+    fclose(file);
+
+    close(reader);
+    close(writer);
+}
+#endif
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -24,6 +24,7 @@
 #include <iostream>
 
 #include <extras/PeriodicActivity.hpp>
+#include <extras/SlaveActivity.hpp>
 #include <os/TimeService.hpp>
 #include <Logger.hpp>
 
@@ -304,6 +305,55 @@ BOOST_AUTO_TEST_CASE( testOverrun )
 }
 #endif
 
+struct TestStats
+  : public RunnableInterface
+{
+  int count;
+  bool initialize() { count = 0; return true; }
+  void step() {
+      // every tenth cycle overruns the 10ms period
+      usleep( ++count % 10 == 0 ? 15000 : 2000 );
+  }
+  void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testThreadStats )
+{
+  boost::scoped_ptr<TestStats> run( new TestStats() );
+  boost::scoped_ptr<Activity> t( new Activity(25, 0.01, 0,"StatsThread") );
+  t->thread()->setMaxOverrun(-1);
+  t->run( run.get() );
+
+  os::ThreadStats stats;
+  BOOST_REQUIRE( t->thread()->getTimingStats(stats) );
+  BOOST_CHECK_EQUAL( stats.cycles, 0u );
+
+  BOOST_CHECK( t->start() );
+  usleep(500*1000);
+  BOOST_REQUIRE( t->thread()->getTimingStats(stats) );
+  BOOST_CHECK( stats.cycles >= 20 );
+  BOOST_CHECK( stats.missed_deadlines >= 1 );
+  BOOST_CHECK( stats.max_consecutive_misses >= 1 );
+  BOOST_CHECK( stats.max_exec_time >= 15000000 );
+  BOOST_CHECK( stats.max_exec_time >= stats.last_exec_time );
+  BOOST_CHECK( stats.total_exec_time >= stats.max_exec_time );
+  BOOST_CHECK( stats.max_latency >= stats.last_latency );
+  unsigned long long histogram = 0;
+  for (int i = 0; i != os::ThreadStats::HistogramSize; ++i)
+      histogram += stats.exec_histogram[i];
+  BOOST_CHECK_EQUAL( histogram, stats.cycles );
+  BOOST_CHECK( stats.exec_histogram[os::ThreadStats::HistogramSize - 1] >= 1 );
+
+  unsigned long long cycles = stats.cycles;
+  t->thread()->resetTimingStats();
+  usleep(100*1000);
+  BOOST_CHECK( t->stop() );
+  BOOST_REQUIRE( t->thread()->getTimingStats(stats) );
+  BOOST_CHECK( stats.cycles >= 1 );
+  BOOST_CHECK( stats.cycles < cycles );
+  t->run(0);
+}
+
 BOOST_AUTO_TEST_CASE( testThread )
 {
   bool r = false;
@@ -533,6 +583,265 @@ BOOST_AUTO_TEST_CASE( testAllocation )
     testRemoveAllocate();
 }
 
+/**
+ * Records the order in which messages are executed.
+ */
+struct TestLaneMessage
+    : public DisposableInterface
+{
+    std::vector<int>* order;
+    int id;
+    void executeAndDispose() { order->push_back(id); }
+    void dispose() {}
+    bool isError() const { return false; }
+};
+
+BOOST_AUTO_TEST_CASE( testEngineMessageBatches )
+{
+    ExecutionEngine ee;
+    SlaveActivity act( &ee );
+    std::vector<int> order;
+    TestLaneMessage msgs[10];
+    for (int i = 0; i != 10; ++i) {
+        msgs[i].order = &order;
+        msgs[i].id = i;
+    }
+
+    const unsigned int max_batch = ExecutionEngine::MAX_MESSAGE_BATCH;
+    BOOST_CHECK_EQUAL( ee.getMessageBatchSize(), max_batch );
+    BOOST_CHECK( !ee.setMessageBatchSize( 0 ) );
+    BOOST_CHECK( !ee.setMessageBatchSize( max_batch + 1 ) );
+    BOOST_CHECK( ee.setMessageBatchSize( 4 ) );
+    BOOST_CHECK_EQUAL( ee.getMessageBatchSize(), 4u );
+    BOOST_CHECK( act.start() );
+
+    // 10 messages are drained in batches of 4, 4 and 2, in order.
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK( ee.process( &msgs[i] ) );
+    BOOST_CHECK( act.execute() );
+    BOOST_CHECK_EQUAL( order.size(), 10u );
+    for (unsigned int i = 0; i != order.size(); ++i)
+        BOOST_CHECK_EQUAL( order[i], int(i) );
+
+    ExecutionEngine::MessageStatistics ms = ee.getMessageStatistics();
+    BOOST_CHECK_EQUAL( ms.batches, 3u );
+    BOOST_CHECK_EQUAL( ms.messages, 10u );
+    BOOST_CHECK_EQUAL( ms.max_batch, 4u );
+    BOOST_CHECK_EQUAL( ms.last_batch, 2u );
+
+    // one by one.
+    BOOST_CHECK( ee.setMessageBatchSize( 1 ) );
+    order.clear();
+    for (int i = 0; i != 3; ++i)
+        BOOST_CHECK( ee.process( &msgs[i] ) );
+    BOOST_CHECK( act.execute() );
+    BOOST_CHECK_EQUAL( order.size(), 3u );
+    ms = ee.getMessageStatistics();
+    BOOST_CHECK_EQUAL( ms.batches, 6u );
+    BOOST_CHECK_EQUAL( ms.messages, 13u );
+    BOOST_CHECK_EQUAL( ms.max_batch, 4u );
+    BOOST_CHECK_EQUAL( ms.last_batch, 1u );
+
+    ee.resetMessageStatistics();
+    ms = ee.getMessageStatistics();
+    BOOST_CHECK_EQUAL( ms.batches, 0u );
+    BOOST_CHECK_EQUAL( ms.messages, 0u );
+    BOOST_CHECK_EQUAL( ms.max_batch, 0u );
+    BOOST_CHECK( act.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testEngineLanes )
+{
+    ExecutionEngine ee;
+    SlaveActivity act( &ee );
+    std::vector<int> order;
+    TestLaneMessage msgs[9];
+    for (int i = 0; i != 9; ++i) {
+        msgs[i].order = &order;
+        msgs[i].id = i;
+    }
+
+    BOOST_CHECK( ee.setLaneCapacity( ExecutionEngine::BackgroundLane, 4 ) );
+    BOOST_CHECK_EQUAL( ee.getLaneCapacity( ExecutionEngine::BackgroundLane ), 4u );
+    ee.setLaneBudget( ExecutionEngine::BackgroundLane, 2 );
+    BOOST_CHECK( act.start() );
+
+    // 0..4 background (4 fit), 5..6 normal, 7..8 critical
+    for (int i = 0; i != 4; ++i)
+        BOOST_CHECK( ee.process( &msgs[i], ExecutionEngine::BackgroundLane ) );
+    BOOST_CHECK( !ee.process( &msgs[4], ExecutionEngine::BackgroundLane ) );
+    BOOST_CHECK( ee.process( &msgs[5] ) );
+    BOOST_CHECK( ee.process( &msgs[6], ExecutionEngine::NormalLane ) );
+    BOOST_CHECK( ee.process( &msgs[7], ExecutionEngine::CriticalLane ) );
+    BOOST_CHECK( ee.process( &msgs[8], ExecutionEngine::CriticalLane ) );
+
+    BOOST_CHECK( act.execute() );
+    int first[] = { 7, 8, 5, 6, 0, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), first, first + 6 );
+
+    order.clear();
+    BOOST_CHECK( act.execute() );
+    int second[] = { 2, 3 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), second, second + 2 );
+    BOOST_CHECK( act.stop() );
+}
+
+BOOST_AUTO_TEST_CASE( testEngineLaneOverflow )
+{
+    ExecutionEngine ee;
+    SlaveActivity act( &ee );
+    std::vector<int> order;
+    TestLaneMessage msgs[10];
+    for (int i = 0; i != 10; ++i) {
+        msgs[i].order = &order;
+        msgs[i].id = i;
+    }
+    const ExecutionEngine::Lane bg = ExecutionEngine::BackgroundLane;
+
+    BOOST_CHECK( ee.setLaneCapacity( bg, 2 ) );
+    BOOST_CHECK( act.start() );
+    BOOST_CHECK( ee.process( &msgs[0], bg ) );
+    BOOST_CHECK( ee.process( &msgs[1], bg ) );
+    BOOST_CHECK( !ee.process( &msgs[2], bg ) );
+    BOOST_CHECK_EQUAL( ee.getLaneStatistics( bg ).drops, 1u );
+
+    // grow while running, the queued messages are kept in front.
+    BOOST_CHECK( ee.setLaneCapacity( bg, 4 ) );
+    BOOST_CHECK_EQUAL( ee.getLaneCapacity( bg ), 4u );
+    for (int i = 2; i != 6; ++i)
+        BOOST_CHECK( ee.process( &msgs[i], bg ) );
+    // the old queue must be drained before the next resize.
+    BOOST_CHECK( !ee.setLaneCapacity( bg, 8 ) );
+
+    BOOST_CHECK( act.execute() );
+    int first[] = { 0, 1, 2, 3, 4, 5 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), first, first + 6 );
+    BOOST_CHECK_EQUAL( ee.getLaneStatistics( bg ).high_water, 6u );
+
+    // shrink, and spill what does not fit.
+    BOOST_CHECK( ee.setLaneCapacity( bg, 1 ) );
+    ee.setLaneOverflowPolicy( bg, ExecutionEngine::SpillOnOverflow );
+    order.clear();
+    BOOST_CHECK( ee.process( &msgs[6], bg ) );
+    BOOST_CHECK( ee.process( &msgs[7], bg ) );
+    BOOST_CHECK( ee.process( &msgs[8], bg ) );
+    BOOST_CHECK_EQUAL( ee.getLaneStatistics( bg ).spills, 2u );
+    BOOST_CHECK( act.execute() );
+    int second[] = { 6, 7, 8 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), second, second + 3 );
+
+    // blocking on ourselves falls back to dropping.
+    ee.setLaneOverflowPolicy( bg, ExecutionEngine::BlockOnOverflow );
+    BOOST_CHECK( ee.process( &msgs[9], bg ) );
+    BOOST_CHECK( !ee.process( &msgs[0], bg ) );
+    BOOST_CHECK_EQUAL( ee.getLaneStatistics( bg ).drops, 2u );
+    BOOST_CHECK_EQUAL( ee.getLaneStatistics( bg ).blocks, 0u );
+
+    ee.resetLaneStatistics( bg );
+    BOOST_CHECK_EQUAL( ee.getLaneStatistics( bg ).drops, 0u );
+    BOOST_CHECK( act.execute() );
+    BOOST_CHECK( act.stop() );
+}
+
+struct TestRunFunction
+    : public ExecutableInterface
+{
+    std::vector<int>* order;
+    int id;
+    int runs;
+    int max;
+    bool remove_self;
+    TestRunFunction() : order(0), id(0), runs(0), max(0), remove_self(false) {}
+    bool execute() {
+        order->push_back(id);
+        ++runs;
+        if ( remove_self )
+            engine->removeSelfFunction(this);
+        return max == 0 || runs < max;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( testEngineRunList )
+{
+    std::vector<int> order;
+    TestRunFunction fs[5];
+    for (int i = 0; i != 5; ++i) {
+        fs[i].order = &order;
+        fs[i].id = i;
+    }
+    fs[2].max = 1;
+    fs[3].remove_self = true;
+
+    ExecutionEngine ee;
+    SlaveActivity act( &ee );
+    BOOST_CHECK( act.start() );
+    for (int i = 0; i != 4; ++i)
+        BOOST_CHECK( ee.runFunction( &fs[i] ) );
+    BOOST_CHECK( ee.runFunction( &fs[4], ExecutionEngine::CriticalLane ) );
+
+    BOOST_CHECK( act.execute() );
+    int first[] = { 4, 0, 1, 2, 3 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), first, first + 5 );
+    BOOST_CHECK( !fs[2].isLoaded() );
+
+    order.clear();
+    BOOST_CHECK( act.execute() );
+    int second[] = { 4, 0, 1 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), second, second + 3 );
+
+    // removal from a running engine goes through its message queue.
+    BOOST_CHECK( ee.removeFunction( &fs[1] ) );
+    BOOST_CHECK( !fs[1].isLoaded() );
+    order.clear();
+    BOOST_CHECK( act.execute() );
+    int third[] = { 4, 0 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), third, third + 2 );
+
+    BOOST_CHECK( act.stop() );
+    BOOST_CHECK( ee.removeFunction( &fs[4] ) );
+    BOOST_CHECK( !fs[4].isLoaded() );
+}
+
+BOOST_AUTO_TEST_CASE( testEngineProfile )
+{
+    ExecutionEngine ee;
+    SlaveActivity act( &ee );
+    BOOST_CHECK( act.start() );
+    BOOST_CHECK( !ee.isProfiling() );
+    BOOST_CHECK( act.execute() );
+    BOOST_CHECK_EQUAL( ee.getPhaseStatistics( ExecutionEngine::UpdatePhase ).count, 0ul );
+
+    ee.setProfiling( true );
+    for (int i = 0; i != 3; ++i)
+        BOOST_CHECK( act.execute() );
+    for (int p = 0; p != ExecutionEngine::CycleJitter; ++p) {
+        ExecutionEngine::PhaseStatistics ps = ee.getPhaseStatistics( ExecutionEngine::ProfilePhase(p) );
+        BOOST_CHECK_EQUAL( ps.count, 3ul );
+        BOOST_CHECK( ps.min <= ps.max );
+        BOOST_CHECK( ps.total >= ps.max );
+        unsigned int samples = 0;
+        for (unsigned int b = 0; b != ExecutionEngine::PROFILE_BUCKETS; ++b)
+            samples += ps.histogram[b];
+        BOOST_CHECK_EQUAL( samples, 3u );
+    }
+    // a non periodic activity has no jitter.
+    BOOST_CHECK_EQUAL( ee.getPhaseStatistics( ExecutionEngine::CycleJitter ).count, 0ul );
+
+    ee.resetProfile();
+    BOOST_CHECK_EQUAL( ee.getPhaseStatistics( ExecutionEngine::MessagesPhase ).count, 0ul );
+    BOOST_CHECK( act.execute() );
+    BOOST_CHECK_EQUAL( ee.getPhaseStatistics( ExecutionEngine::MessagesPhase ).count, 1ul );
+
+    ee.setProfiling( false );
+    BOOST_CHECK( act.execute() );
+    BOOST_CHECK_EQUAL( ee.getPhaseStatistics( ExecutionEngine::MessagesPhase ).count, 1ul );
+    BOOST_CHECK( act.stop() );
+
+    TaskContext tc("profiled");
+    BOOST_CHECK( tc.getCycleProfile( ExecutionEngine::ProfilePhaseCount ).empty() );
+    BOOST_CHECK_EQUAL( tc.getCycleProfile( ExecutionEngine::UpdatePhase ).size(), 4 + ExecutionEngine::PROFILE_BUCKETS );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 void ActivitiesTest::testAddRunnableInterface()
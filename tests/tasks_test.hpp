@@ -52,6 +52,7 @@ public:
     void tearDown();
 
     void testOverrun();
+    void testThreadStats();
 
     void testStartStop();
     void testStart();
@@ -22,6 +22,7 @@
 #include "taskthread_test.hpp"
 
 #include <iostream>
+#include <algorithm>
 
 #include <extras/Activities.hpp>
 #include <extras/TimerThread.hpp>
@@ -213,6 +214,77 @@ BOOST_AUTO_TEST_CASE(testPeriodic )
     BOOST_CHECK( mtask.thread()->isRunning() == true);
 }
 
+struct TickRunner
+    : public RunnableInterface
+{
+    std::vector<int>& steps;
+    int id;
+    TickRunner(std::vector<int>& steps, int id) : steps(steps), id(id) {}
+    bool initialize() { return true; }
+    void step() { steps.push_back(id); }
+    void finalize() {}
+};
+
+BOOST_AUTO_TEST_CASE( testTickSchedule )
+{
+    TimerThreadPtr tt( new TimerThread(ORO_SCHED_OTHER, os::LowestPriority, "TickScheduleThread", 0.01) );
+    std::vector<int> steps;
+    steps.reserve(1000);
+    TickRunner r0(steps, 0), r1(steps, 1), r2(steps, 2);
+    PeriodicActivity a0(tt, &r0), a1(tt, &r1), a2(tt, &r2);
+
+    BOOST_CHECK( a0.setTickSchedule(2, 0) );
+    BOOST_CHECK( a1.setTickSchedule(2, 1) );
+    BOOST_CHECK( !a2.setTickSchedule(2, 2) );
+    BOOST_CHECK( !a2.setTickSchedule(0, 0) );
+    BOOST_CHECK_EQUAL( 2u, a1.getTickMultiple() );
+    BOOST_CHECK_EQUAL( 1u, a1.getTickPhase() );
+    BOOST_CHECK_CLOSE( 2 * tt->getPeriod(), a1.getPeriod(), 0.001 );
+    BOOST_CHECK_CLOSE( tt->getPeriod(), a2.getPeriod(), 0.001 );
+
+    // More activities than TimerThread::MAX_ACTIVITIES
+    std::vector<TickRunner*> runners;
+    std::vector<PeriodicActivity*> many;
+    for (unsigned int i = 0; i != TimerThread::MAX_ACTIVITIES + 10; ++i) {
+        runners.push_back( new TickRunner(steps, 3) );
+        many.push_back( new PeriodicActivity(tt, runners.back()) );
+        BOOST_CHECK( many.back()->setTickSchedule(10, i % 10) );
+    }
+
+    BOOST_CHECK( a2.start() );
+    BOOST_CHECK( a0.start() );
+    BOOST_CHECK( a1.start() );
+    BOOST_CHECK( !a0.setTickSchedule(1, 0) );
+    for (unsigned int i = 0; i != many.size(); ++i)
+        BOOST_CHECK( many[i]->start() );
+    usleep(500000);
+    BOOST_CHECK( a0.stop() );
+    BOOST_CHECK( a1.stop() );
+    BOOST_CHECK( a2.stop() );
+    for (unsigned int i = 0; i != many.size(); ++i) {
+        delete many[i];
+        delete runners[i];
+    }
+
+    // Once all are started, each tick runs a2 first, followed by a0 and
+    // a1 in turn and a tenth of the others.
+    std::vector<int> ticks;
+    for (unsigned int i = 0; i != steps.size(); ++i)
+        if (steps[i] != 3)
+            ticks.push_back(steps[i]);
+    unsigned int start = ticks.size() / 2;
+    if ( ticks[start] != 2 )
+        ++start;
+    BOOST_REQUIRE( ticks.size() - start > 10 );
+    int expect = ticks[start + 1];
+    for (unsigned int i = start; i + 1 < ticks.size(); i += 2) {
+        BOOST_CHECK_EQUAL( 2, ticks[i] );
+        BOOST_CHECK_EQUAL( expect, ticks[i + 1] );
+        expect = 1 - expect;
+    }
+    BOOST_CHECK( count(steps.begin(), steps.end(), 3) >= int(TimerThread::MAX_ACTIVITIES + 10) );
+}
+
 BOOST_AUTO_TEST_CASE( testNonPeriodic )
 {
     // Test periodic task sequencing...
@@ -436,6 +508,40 @@ BOOST_AUTO_TEST_CASE( testScheduler )
     }
 }
 
+/**
+ * A reservation may be refused by the OS (no SCHED_DEADLINE or
+ * no permission), but a refused one must leave the thread untouched.
+ */
+BOOST_AUTO_TEST_CASE( testReservation )
+{
+    Activity act(ORO_SCHED_OTHER, 0, 0.01);
+    BOOST_CHECK( act.start() );
+    BOOST_CHECK_EQUAL( 0.0, act.getReservation() );
+
+    // a budget larger than the period is never accepted.
+    BOOST_CHECK( act.setReservation(0.02) == false );
+    BOOST_CHECK( act.setReservation(0.002, 0.02) == false );
+    BOOST_CHECK_EQUAL( 0.0, act.getReservation() );
+    BOOST_CHECK_EQUAL( ORO_SCHED_OTHER, act.getScheduler() );
+
+    if ( act.setReservation(0.002, 0.005) ) {
+        BOOST_CHECK_EQUAL( 0.002, act.getReservation() );
+        BOOST_CHECK( act.getScheduler() != ORO_SCHED_OTHER );
+        // follows the period.
+        BOOST_CHECK( act.setPeriod(0.02) );
+        usleep(100000);
+        BOOST_CHECK( act.isRunning() );
+        BOOST_CHECK_EQUAL( 0.002, act.getReservation() );
+    } else {
+        BOOST_CHECK_EQUAL( 0.0, act.getReservation() );
+    }
+
+    BOOST_CHECK( act.setReservation(0) );
+    BOOST_CHECK_EQUAL( 0.0, act.getReservation() );
+    BOOST_CHECK_EQUAL( ORO_SCHED_OTHER, act.getScheduler() );
+    BOOST_CHECK( act.stop() );
+}
+
 /**
  * Checks if the rtos_task_get_pid function works properly.
  */
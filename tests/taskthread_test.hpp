@@ -57,10 +57,12 @@ public:
 #endif
     void testThreadConfig();
     void testPeriodic();
+    void testTickSchedule();
     void testNonPeriodic();
     void testSlave();
     void testSequential();
     void testScheduler();
+    void testReservation();
     void testAllocation();
 };
 
@@ -212,6 +212,43 @@ BOOST_AUTO_TEST_CASE( testTimers )
     BOOST_CHECK( timer.occured.size() == 0 );
 }
 
+struct BatchTimer
+    : public Timer
+{
+    std::vector<Timer::TimerId> occured;
+    int batches;
+    BatchTimer()
+        :Timer(1000, ORO_SCHED_RT, os::HighestPriority), batches(0)
+    {
+        occured.reserve(1000);
+    }
+    void timeout(const Timer::TimerIdList& ids)
+    {
+        ++batches;
+        occured.insert( occured.end(), ids.begin(), ids.end() );
+    }
+};
+
+BOOST_AUTO_TEST_CASE( testTimerBatch )
+{
+    BatchTimer timer;
+    for (int i = 0; i != 1000; ++i)
+        BOOST_CHECK( timer.arm(i, 0.5) );
+    for (int i = 1; i < 1000; i += 2)
+        BOOST_CHECK( timer.killTimer(i) );
+    BOOST_CHECK( timer.arm(1000, 0.5) == false );
+
+    sleep(1);
+
+    // Only the even timers expired, once and in order of expiry.
+    BOOST_REQUIRE_EQUAL( timer.occured.size(), 500u );
+    for (int i = 0; i != 500; ++i)
+        BOOST_CHECK_EQUAL( timer.occured[i], 2 * i );
+    BOOST_CHECK( timer.batches >= 1 && timer.batches <= 500 );
+    for (int i = 0; i != 1000; ++i)
+        BOOST_CHECK( !timer.isArmed(i) );
+}
+
 BOOST_AUTO_TEST_CASE( testTimerPeriod )
 {
     TestTimer timer;
@@ -42,6 +42,7 @@ public:
     void testTicksConversion();
     void testTimeProgress();
     void testTimers();
+    void testTimerBatch();
     void testTimerPeriod();
 
 };